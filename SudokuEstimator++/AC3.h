@@ -1,117 +1,185 @@
 #pragma once
-#include <queue>
+#include <cassert>
+#include <cstdint>
 
+#include "Bits.h"
+#include "Peers.h"
 #include "Sudoku.h"
 
+// Queue of the arcs (i, j) that ac3() still has to check, every estimator allocates one up front so that ac3() never allocates
+// Every arc has a bit in 'queued', an arc that is already in the queue is not pushed again, since checking it once covers both.
+// As no arc is queued twice, the ring buffer never has to hold more than all arcs of the grid at once.
 template<int N, int M>
-bool ac3(Sudoku<N, M> * sudoku) {
-	assert(sudoku->size < 256); // Cell coordinates need to be packed into a single byte
+struct ArcQueue {
+	static constexpr int size       = N * M;
+	static constexpr int cell_count = size * size;
 
-	std::queue<unsigned int> constraints;
+	// Smallest power of two that fits all arcs, so that the ring buffer can wrap with a mask
+	static constexpr unsigned int capacity = [] {
+		unsigned int capacity = 1;
+		while (capacity < (unsigned int)(cell_count * Peers<N, M>::max_count)) capacity <<= 1;
+
+		return capacity;
+	}();
+
+	static constexpr int queued_word_count = (cell_count * cell_count + 63) / 64;
+
+private:
+	uint32_t * arcs;   // Ring buffer of arcs, i << 16 | j
+	uint64_t * queued; // Bit i * cell_count + j is set while arc (i, j) is in the queue
+
+	unsigned int head = 0;
+	unsigned int tail = 0;
+
+	inline uint64_t & get_queued_word(int i, int j, uint64_t & bit) {
+		int arc = i * cell_count + j;
+
+		bit = 1ull << (arc & 63);
+
+		return queued[arc >> 6];
+	}
+
+public:
+	inline ArcQueue() {
+		arcs   = new uint32_t[capacity];
+		queued = new uint64_t[queued_word_count]();
+	}
+
+	inline ~ArcQueue() {
+		delete[] arcs;
+		delete[] queued;
+	}
+
+	ArcQueue(const ArcQueue &) = delete;
+	ArcQueue & operator=(const ArcQueue &) = delete;
+
+	inline bool is_empty() const {
+		return head == tail;
+	}
+
+	inline void push(int i, int j) {
+		uint64_t   bit;
+		uint64_t & word = get_queued_word(i, j, bit);
+
+		if (word & bit) return;
+		word |= bit;
+
+		assert(tail - head < capacity);
+
+		arcs[tail++ & (capacity - 1)] = (uint32_t)i << 16 | (uint32_t)j;
+	}
+
+	inline void pop(int & i, int & j) {
+		assert(!is_empty());
+
+		uint32_t arc = arcs[head++ & (capacity - 1)];
+
+		i = arc >> 16;
+		j = arc & 0xffff;
+
+		uint64_t   bit;
+		uint64_t & word = get_queued_word(i, j, bit);
+
+		word &= ~bit;
+	}
+
+	// Empties the queue, after ac3() returned early
+	inline void clear() {
+		int i, j;
+		while (!is_empty()) pop(i, j);
+	}
+};
+
+template<int N, int M, template<int, int> typename SudokuType>
+bool ac3(SudokuType<N, M> * sudoku, ArcQueue<N, M> & constraints) {
+	constexpr int cell_count = ArcQueue<N, M>::cell_count;
+
+	assert(constraints.is_empty());
 
 	// Enqueue all constraints
-	for (int yi = 0; yi < sudoku->size; yi++) {
-		for (int xi = 0; xi < sudoku->size; xi++) {
-			// Calculate current block bounds
-			int bx = M * (xi / M);
-			int by = N * (yi / N);
-
-			int bxe = bx + M;
-			int bye = by + N;
-
-			unsigned int current_cell        = xi << 24 | yi << 16; 
-			unsigned int current_cell_row    = current_cell | yi; 
-			unsigned int current_cell_column = current_cell | xi << 8; 
-
-			// Update all domains in the current row, skipping the cells that are also in the current block
-			for (int xj = 0;   xj < bx;           xj++) constraints.push((unsigned int)(current_cell_row | xj << 8));
-			for (int xj = bxe; xj < sudoku->size; xj++) constraints.push((unsigned int)(current_cell_row | xj << 8));
-
-			// Update all domains in the current column, skipping the cells that are also in the current block
-			for (int yj = 0;   yj < by;           yj++) constraints.push((unsigned int)(current_cell_column | yj));
-			for (int yj = bye; yj < sudoku->size; yj++) constraints.push((unsigned int)(current_cell_column | yj));
-
-			// Update all domains in the current block, except for (xi, yi) and (xj, yj)
-			for (int yj = by; yj < bye; yj++) {
-				for (int xj = bx; xj < bxe; xj++) {
-					if (xj != xi || yj != yi) {
-						constraints.push((unsigned int)(current_cell | xj << 8 | yj));
-					}
-				}
-			}
+	// Filled in cells are already enforced by forward checking, only arcs between empty cells can remove values
+	for (int i = 0; i < cell_count; i++) {
+		if (sudoku->grid[i] != 0) continue;
+
+		const unsigned short * cell_peers = peers<N, M>.indices[i];
+		int                    peer_count = peers<N, M>.count  [i];
+
+		for (int p = 0; p < peer_count; p++) {
+			if (sudoku->grid[cell_peers[p]] == 0) constraints.push(i, cell_peers[p]);
 		}
 	}
 
-	int domain_i[Sudoku<N, M>::size];
-	int domain_j[Sudoku<N, M>::size];
-
-	do {
-		unsigned int cij = constraints.front();
-		constraints.pop();
+	while (!constraints.is_empty()) {
+		int index_i, index_j;
+		constraints.pop(index_i, index_j);
 
-		int xi = (int)(cij & 0xff000000) >> 24, yi = (int)(cij & 0x00ff0000) >> 16;
-		int xj = (int)(cij & 0x0000ff00) >> 8,  yj = (int)(cij & 0x000000ff);
+		if (sudoku->grid[index_i] != 0 || sudoku->grid[index_j] != 0) continue;
 
-		int index_i = Sudoku<N, M>::get_index(xi, yi);
-		int index_j = Sudoku<N, M>::get_index(xj, yj); 
+		if (sudoku->get_domain_size(index_j) != 1) continue;
 
-		bool modified = false;
+		int value = Bits::count_trailing_zeros((uint32_t)sudoku->get_domain_mask(index_j));
 
-		int domain_size_j = sudoku->get_domain(index_j, domain_j);
+		if (!sudoku->is_valid_move(index_i, value)) continue;
 
-		if (domain_size_j == 1) {
-			int domain_size_i = sudoku->get_domain(index_i, domain_i);
+		// Remove the value from the domain
+		// If the domain is now empty, the Sudoku is not valid
+		if (!sudoku->remove_from_domain(index_i, value)) {
+			constraints.clear();
 
-			for (int di = 0; di < domain_size_i; di++) {
-				if (domain_i[di] == domain_j[0]) {
-					
-					unsigned char& constraint = sudoku->constraints[index_i * Sudoku<N, M>::size + domain_i[di]];
+			return false;
+		}
 
-					// If domain_i[di] was previously unconstrained, it is now
-					if (constraint == 0) {
-						// Remove the value from the domain
-						unsigned char& domain_size = sudoku->domain_sizes[index_i];
-						domain_size--;
+		// Update all domains of the peers of i, except for j
+		const unsigned short * cell_peers = peers<N, M>.indices[index_i];
+		int                    peer_count = peers<N, M>.count  [index_i];
 
-						// If the domain is now empty, the Sudoku is not valid
-						if (domain_size == 0) return false;
-					}
+		for (int p = 0; p < peer_count; p++) {
+			int index_k = cell_peers[p];
 
-					constraint++;
+			if (index_k != index_j && sudoku->grid[index_k] == 0) constraints.push(index_k, index_i);
+		}
+	}
 
-					// Calculate current block bounds
-					int bx = M * (xi / M);
-					int by = N * (yi / N);
+	return true;
+}
+
+// Reaches the same fixpoint as ac3(), but only does the work the current grid needs
+// An arc (i, j) can only remove a value from i if j is an empty cell with a single value left, so instead of every arc of the grid,
+// the worklist holds the empty cells that are down to a single value. Processing such a cell removes its value from its empty peers,
+// and every peer that is left with a single value is pushed in turn.
+// Domains only shrink, so a cell reaches a single value at most once and is never pushed twice.
+template<int N, int M, template<int, int> typename SudokuType>
+bool ac3_incremental(SudokuType<N, M> * sudoku) {
+	constexpr int size = N * M;
+
+	int worklist[size * size];
+	int worklist_length = 0;
+
+	// Only the cells that the Latin Rectangle and the random walk filled in have changed domains since the reset,
+	// but their peers cover most of the grid, so a scan over the domain sizes is cheaper than visiting them
+	for (int i = 0; i < size * size; i++) {
+		if (sudoku->grid[i] == 0 && sudoku->get_domain_size(i) == 1) worklist[worklist_length++] = i;
+	}
 
-					int bxe = bx + M;
-					int bye = by + N;
+	while (worklist_length > 0) {
+		int cell_index = worklist[--worklist_length];
+		int value      = Bits::count_trailing_zeros((uint32_t)sudoku->get_domain_mask(cell_index));
 
-					unsigned int current_cell        = xi << 8 | yi;
-					unsigned int current_cell_row    = current_cell | yi << 16; 
-					unsigned int current_cell_column = current_cell | xi << 24; 
+		const unsigned short * cell_peers = peers<N, M>.indices[cell_index];
+		int                    peer_count = peers<N, M>.count  [cell_index];
 
-					// Update all domains in the current row, skipping the cells that are also in the current block
-					for (int xk = 0;   xk < bx;           xk++) if (xk != xj) constraints.push((unsigned int)(xk << 24 | current_cell_row));
-					for (int xk = bxe; xk < sudoku->size; xk++) if (xk != xj) constraints.push((unsigned int)(xk << 24 | current_cell_row));
+		for (int i = 0; i < peer_count; i++) {
+			int peer = cell_peers[i];
 
-					// Update all domains in the current column, skipping the cells that are also in the current block
-					for (int yk = 0;   yk < by;           yk++) if (yk != yj) constraints.push((unsigned int)(current_cell_column | yk << 16));
-					for (int yk = bye; yk < sudoku->size; yk++) if (yk != yj) constraints.push((unsigned int)(current_cell_column | yk << 16));
+			// Filled in cells are already enforced by forward checking
+			if (sudoku->grid[peer] != 0 || !sudoku->is_valid_move(peer, value)) continue;
 
-					// Update all domains in the current block, except for (xi, yi) and (xj, yj)
-					for (int yk = by; yk < bye; yk++) {
-						for (int xk = bx; xk < bxe; xk++) {
-							if ((xk != xi || yk != yi) && (xk != xj || yk != yj)) {
-								constraints.push((unsigned int)(xk << 24 | yk << 16 | current_cell));
-							}
-						}
-					}
+			// If the domain is now empty, the Sudoku is not valid
+			if (!sudoku->remove_from_domain(peer, value)) return false;
 
-					break;
-				}
-			}
+			if (sudoku->get_domain_size(peer) == 1) worklist[worklist_length++] = peer;
 		}
-	} while (constraints.size() > 0);
+	}
 
 	return true;
-}
\ No newline at end of file
+}
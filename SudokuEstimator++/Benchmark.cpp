@@ -0,0 +1,408 @@
+#include "Benchmark.h"
+
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include "SudokuEstimator.h"
+#include "Statistics.h"
+#include "AC3.h"
+
+// Returns the time in nanoseconds that has passed since 'start_time'
+static double elapsed_ns(std::chrono::high_resolution_clock::time_point start_time) {
+	auto stop_time = std::chrono::high_resolution_clock::now();
+
+	return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(stop_time - start_time).count();
+}
+
+// Prints the mean, standard deviation and minimum of the ns/op of all repetitions
+static void print_measurement(const char * name, const std::vector<double> & ns_per_op) {
+	if (ns_per_op.empty()) {
+		printf("  %-44s %12s\n", name, "n/a");
+
+		return;
+	}
+
+	double mean = 0.0;
+	for (double x : ns_per_op) mean += x;
+	mean /= ns_per_op.size();
+
+	double variance = 0.0;
+	for (double x : ns_per_op) variance += (x - mean) * (x - mean);
+	variance /= ns_per_op.size();
+
+	double min = *std::min_element(ns_per_op.begin(), ns_per_op.end());
+
+	printf("  %-44s %12.1f ns/op  +- %9.1f  (min %12.1f)\n", name, mean, sqrt(variance), min);
+}
+
+template<int N, int M>
+struct EstimatorBenchmark {
+	using Estimator = SudokuEstimator<N, M>;
+
+	// Number of operations per repetition, for steps that are timed one at a time and for steps that are timed in bulk
+	static constexpr int sample_count    = Sudoku<N, M>::size <= 9 ? 2000 : 200;
+	static constexpr int operation_count = 100000;
+
+	// Number of samples to compare the proposals on, the relative variance is only stable over many samples
+	// On 4x4 a sample takes tens of milliseconds, so fewer samples are used there
+	static constexpr int proposal_sample_count = Sudoku<N, M>::size <= 12 ? 40000 : 400;
+
+	// Caps the average number of attempts to reach a state in which a step can be timed, for random walks that nearly always fail
+	static constexpr int max_attempts_per_sample = 1000;
+
+	Estimator * estimator;
+
+	// Coordinates of a freshly constructed estimator, the random walks shuffle them in place
+	int initial_coordinates[Estimator::coordinate_count];
+
+	inline EstimatorBenchmark(int random_walk_length) {
+		estimator = new Estimator(random_walk_length);
+
+		std::copy(estimator->coordinates, estimator->coordinates + Estimator::coordinate_count, initial_coordinates);
+	}
+
+	inline ~EstimatorBenchmark() {
+		delete estimator;
+	}
+
+	// The prepare functions bring the estimator to the state right before the corresponding step of estimate_solution_count()
+	// They return false if a dead end was reached before that step
+	inline bool prepare_knuth() {
+		estimator->sudoku.reset();
+
+		if (!estimator->fill_latin_rectangle()) return false;
+
+		Random::partial_shuffle(estimator->coordinates, Estimator::coordinate_count, estimator->random_walk_length, estimator->rng);
+
+		return true;
+	}
+
+	inline bool prepare_ac3() {
+		if (!prepare_knuth()) return false;
+
+		estimator->knuth();
+
+		return !estimator->estimate.is_zero();
+	}
+
+	inline bool prepare_backtrack() {
+		if (!prepare_ac3()) return false;
+
+		if (!estimator->enforce_arc_consistency()) return false;
+
+		estimator->traverser.seek_first(&estimator->sudoku);
+
+		return true;
+	}
+
+	// Reseeds the random number generator and restores the coordinates, so that every benchmark that starts
+	// the same repetition sees the same samples regardless of the benchmarks that ran before it
+	inline void restart(int repetition) {
+		estimator->rng = Random::Generator(Random::derive_key(BENCHMARK_SEED, 0, repetition));
+
+		std::copy(initial_coordinates, initial_coordinates + Estimator::coordinate_count, estimator->coordinates);
+	}
+
+	// Runs all repetitions of a benchmark, 'repetition' returns the ns/op of a single repetition or a negative number if it failed
+	template<typename Repetition>
+	inline void measure(const char * name, Repetition repetition) {
+		std::vector<double> ns_per_op;
+
+		for (int i = 0; i < BENCHMARK_REPETITION_COUNT; i++) {
+			restart(i);
+
+			double result = repetition();
+			if (result < 0.0) {
+				ns_per_op.clear();
+
+				break;
+			}
+
+			ns_per_op.push_back(result);
+		}
+
+		print_measurement(name, ns_per_op);
+	}
+
+	// Times 'operation' once for each of 'sample_count' states obtained through 'prepare'
+	template<typename Prepare, typename Operation>
+	inline double time_samples(Prepare prepare, Operation operation) {
+		double total_ns = 0.0;
+
+		int attempts = 0;
+
+		for (int i = 0; i < sample_count; i++) {
+			while (!prepare()) {
+				if (++attempts > max_attempts_per_sample * sample_count) return -1.0;
+			}
+
+			auto start_time = std::chrono::high_resolution_clock::now();
+
+			operation();
+
+			total_ns += elapsed_ns(start_time);
+		}
+
+		return total_ns / sample_count;
+	}
+
+	// Runs 'proposal_sample_count' samples with the given proposal, and prints the fraction of zero estimates,
+	// the relative variance of the estimates, the time per sample and their product, the variance per CPU-second
+	inline void measure_proposal(Knuth::Proposal proposal) {
+		restart(0);
+
+		estimator->proposal = proposal;
+		estimator->transposition_table.clear();
+
+		RunningStatistics statistics;
+
+		int zero_count = 0;
+
+		auto start_time = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < proposal_sample_count; i++) {
+			estimator->estimate_solution_count();
+
+			zero_count += estimator->estimate.is_zero();
+
+			statistics.add(Estimator::get_scaled_estimate(estimator->estimate));
+		}
+
+		double us_per_sample     = elapsed_ns(start_time) / proposal_sample_count / 1000.0;
+		double relative_variance = statistics.get_relative_variance();
+
+		char name[64];
+		snprintf(name, sizeof(name), "%s proposal", Knuth::get_name(proposal));
+
+		printf("  %-44s %12.1f us/sample, %5.1f%% zero, relative variance %10.1f, %12.1f us\n", name,
+			us_per_sample,
+			100.0 * zero_count / proposal_sample_count,
+			relative_variance,
+			relative_variance * us_per_sample
+		);
+
+		estimator->proposal = knuth_proposal;
+	}
+
+	inline void run() {
+		int rows[M][Sudoku<N, M>::size];
+
+		measure("Latin Rectangle (rejection)", [&]() {
+			auto start_time = std::chrono::high_resolution_clock::now();
+
+			for (int i = 0; i < sample_count; i++) {
+				LatinRectangle::sample_rejection<N, M>(rows, estimator->rng);
+			}
+
+			return elapsed_ns(start_time) / sample_count;
+		});
+
+		measure("Latin Rectangle (sequential)", [&]() {
+			typename Estimator::Estimate weight;
+
+			auto start_time = std::chrono::high_resolution_clock::now();
+
+			for (int i = 0; i < sample_count; i++) {
+				weight = 1;
+				LatinRectangle::sample_sequential<N, M>(rows, weight, estimator->rng);
+			}
+
+			return elapsed_ns(start_time) / sample_count;
+		});
+
+		measure("set_with_forward_check + reset_cell", [&]() {
+			while (!prepare_knuth()) { }
+
+			// Collect moves into the empty cells of the state after filling in the Latin Rectangle
+			int cells [Estimator::coordinate_count];
+			int values[Estimator::coordinate_count];
+			int move_count = 0;
+
+			int domain[Sudoku<N, M>::size];
+
+			for (int i = 0; i < Estimator::coordinate_count; i++) {
+				int cell_index  = estimator->coordinates[i];
+				int domain_size = estimator->sudoku.get_domain(cell_index, domain);
+
+				if (domain_size > 0) {
+					cells [move_count] = cell_index;
+					values[move_count] = domain[estimator->rng() % domain_size];
+					move_count++;
+				}
+			}
+
+			int valid_count = 0;
+
+			auto start_time = std::chrono::high_resolution_clock::now();
+
+			for (int i = 0; i < operation_count; i++) {
+				int move = i % move_count;
+
+				valid_count += estimator->sudoku.set_with_forward_check(cells[move], values[move]);
+				estimator->sudoku.reset_cell(cells[move]);
+			}
+
+			double ns = elapsed_ns(start_time) / operation_count;
+
+			return valid_count >= 0 ? ns : -1.0; // Keeps the result of set_with_forward_check alive
+		});
+
+		measure("knuth()", [&]() {
+			return time_samples([&]() { return prepare_knuth(); }, [&]() { estimator->knuth(); });
+		});
+
+		measure("ac3()", [&]() {
+			return time_samples([&]() { return prepare_ac3(); }, [&]() { ac3(&estimator->sudoku, estimator->arc_queue); });
+		});
+
+		measure("ac3_incremental()", [&]() {
+			return time_samples([&]() { return prepare_ac3(); }, [&]() { ac3_incremental(&estimator->sudoku); });
+		});
+
+		measure(use_bucket_traverser ? "BucketTraverser::move()" : "MostConstrainedTraverser::move()", [&]() {
+			double total_ns = 0.0;
+
+			int index_sum = 0;
+			int attempts  = 0;
+
+			for (int i = 0; i < sample_count; i++) {
+				while (!prepare_backtrack()) {
+					if (++attempts > max_attempts_per_sample * sample_count) return -1.0;
+				}
+
+				auto start_time = std::chrono::high_resolution_clock::now();
+
+				for (int j = 0; j < operation_count / sample_count; j++) {
+					estimator->traverser.move(&estimator->sudoku);
+
+					index_sum += estimator->traverser.index;
+				}
+
+				total_ns += elapsed_ns(start_time);
+			}
+
+			double ns = total_ns / (sample_count * (operation_count / sample_count));
+
+			return index_sum >= 0 ? ns : -1.0; // Keeps the result of move alive
+		});
+
+		measure("backtrack_with_forward_check()", [&]() {
+			return time_samples([&]() { return prepare_backtrack(); }, [&]() {
+				estimator->backtrack = 0;
+				estimator->backtrack_with_forward_check();
+			});
+		});
+
+		measure("backtrack_iterative()", [&]() {
+			return time_samples([&]() { return prepare_backtrack(); }, [&]() {
+				estimator->backtrack = 0;
+				estimator->backtrack_iterative();
+			});
+		});
+
+		measure("estimate_solution_count()", [&]() {
+			auto start_time = std::chrono::high_resolution_clock::now();
+
+			for (int i = 0; i < sample_count; i++) {
+				estimator->estimate_solution_count();
+			}
+
+			return elapsed_ns(start_time) / sample_count;
+		});
+
+		// Samples with the random walks taken KNUTH_BATCH_LANES at a time, timed per sample
+		// The random numbers are drawn in a different order, so these are samples from the same distribution, not the same samples as above
+		measure("estimate_solution_counts()", [&]() {
+			typename Estimator::Estimate estimates[KNUTH_BATCH_LANES];
+
+			auto start_time = std::chrono::high_resolution_clock::now();
+
+			for (int i = 0; i < sample_count; i += KNUTH_BATCH_LANES) {
+				estimator->estimate_solution_counts(estimates, std::min(KNUTH_BATCH_LANES, sample_count - i));
+			}
+
+			return elapsed_ns(start_time) / sample_count;
+		});
+
+		// Backtracking statistics of a fixed set of samples
+		restart(0);
+
+		estimator->node_count = 0;
+		estimator->transposition_table.clear();
+		estimator->transposition_table.reset_statistics();
+
+		for (int i = 0; i < sample_count; i++) {
+			estimator->estimate_solution_count();
+		}
+
+		printf("  %-44s %12.1f nodes/sample\n", "Backtracking nodes", (double)estimator->node_count / sample_count);
+
+		if constexpr (use_transposition_table || use_symmetry_cache) {
+			const TranspositionTable::Statistics & statistics = estimator->transposition_table.statistics;
+
+			printf("  %-44s %12.1f%% of %.1f lookups/sample, %.1f nodes/sample saved\n", "Transposition table hits",
+				statistics.lookup_count > 0 ? 100.0 * statistics.hit_count / statistics.lookup_count : 0.0,
+				(double)statistics.lookup_count     / sample_count,
+				(double)statistics.saved_node_count / sample_count
+			);
+		}
+
+		// The same samples with and without hidden singles, the estimates are the same but the backtracking trees are not
+		for (bool hidden_singles : { false, true }) {
+			restart(0);
+
+			estimator->hidden_singles = hidden_singles;
+			estimator->node_count     = 0;
+			estimator->transposition_table.clear();
+
+			auto start_time = std::chrono::high_resolution_clock::now();
+
+			for (int i = 0; i < sample_count; i++) {
+				estimator->estimate_solution_count();
+			}
+
+			double us_per_sample = elapsed_ns(start_time) / sample_count / 1000.0;
+
+			printf("  %-44s %12.1f nodes/sample, %.1f us/sample\n", hidden_singles ? "Backtracking nodes with hidden singles" : "Backtracking nodes without hidden singles",
+				(double)estimator->node_count / sample_count,
+				us_per_sample
+			);
+		}
+
+		estimator->hidden_singles = Estimator::default_hidden_singles;
+
+		// Lower relative variance times time per sample means fewer CPU-seconds for the same precision
+		printf("  Knuth proposals, %u samples each, the last column is the relative variance times the time per sample\n", proposal_sample_count);
+
+		measure_proposal(Knuth::Proposal::UNIFORM);
+		measure_proposal(Knuth::Proposal::VIABLE);
+		measure_proposal(Knuth::Proposal::PEER_DOMAINS);
+	}
+};
+
+template<int N, int M>
+void run_benchmark(int random_walk_length) {
+	printf("Benchmarking %ux%u with random walks of length %u, %s layout, %s traverser, %s kernels, the %s Latin Rectangle sampler and the %s proposal\n", N, M, random_walk_length,
+		use_bitmask_layout   ? "bitmask" : "counter",
+		use_bucket_traverser ? "bucket"  : "scanning",
+		SIMD::get_name(SIMDKernels<N, M>::instruction_set),
+		LatinRectangle::get_name(latin_rectangle_sampler),
+		Knuth::get_name(knuth_proposal)
+	);
+	printf("%u repetitions with fixed seeds, steps that can be timed individually use %u samples per repetition\n", BENCHMARK_REPETITION_COUNT, EstimatorBenchmark<N, M>::sample_count);
+
+	EstimatorBenchmark<N, M> benchmark(random_walk_length);
+	benchmark.run();
+
+	printf("\n");
+}
+
+// Explicit instantiations for all supported sizes, these need to match the dispatch table in Main.cpp
+template void run_benchmark<2, 2>(int random_walk_length);
+template void run_benchmark<2, 3>(int random_walk_length);
+template void run_benchmark<2, 4>(int random_walk_length);
+template void run_benchmark<3, 3>(int random_walk_length);
+template void run_benchmark<3, 4>(int random_walk_length);
+template void run_benchmark<4, 4>(int random_walk_length);
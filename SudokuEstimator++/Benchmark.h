@@ -0,0 +1,12 @@
+#pragma once
+
+// Number of times every benchmark is repeated, each repetition uses its own fixed seed
+constexpr int BENCHMARK_REPETITION_COUNT = 5;
+constexpr unsigned int BENCHMARK_SEED    = 12345;
+
+// Times the individual steps of the estimator for the given size, and prints ns/op for each of them.
+// Every step is measured BENCHMARK_REPETITION_COUNT times with fixed seeds, the spread between repetitions is reported
+// along with the mean, so that layout and kernel changes can be compared on the same workload.
+// The supported values of N and M are explicitly instantiated in Benchmark.cpp.
+template<int N, int M>
+void run_benchmark(int random_walk_length);
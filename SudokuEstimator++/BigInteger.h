@@ -1,6 +1,11 @@
 #pragma once
+#ifdef _WIN32
 #include <mpirxx.h>
+#else
+#include <gmpxx.h> // MPIR is API compatible with GMP, which is what Linux distributions ship
+#endif
 #include <cassert>
+#include <cstdint>
 
 // MPIR Library is used to handle big integer math
 // This alias is used for convenience
@@ -23,4 +28,14 @@ namespace BigIntegerMath {
 
 		return result;
 	}
+
+	// The constructors only take unsigned long, which is 32 bits on Windows
+	inline BigInteger from_uint64(uint64_t x) {
+		BigInteger result = (unsigned int)(x >> 32);
+
+		result <<= 32;
+		result  += (unsigned int)x;
+
+		return result;
+	}
 };
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Portable wrappers around the bit manipulation intrinsics used by the bitmask based code paths
+namespace Bits {
+	// Number of set bits
+	inline int popcount(uint32_t x) {
+#ifdef _MSC_VER
+		return __popcnt(x);
+#else
+		return __builtin_popcount(x);
+#endif
+	}
+
+	inline int popcount(uint64_t x) {
+#ifdef _MSC_VER
+		return (int)__popcnt64(x);
+#else
+		return __builtin_popcountll(x);
+#endif
+	}
+
+	// Index of the lowest set bit, x should not be zero
+	inline int count_trailing_zeros(uint32_t x) {
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward(&index, x);
+
+		return index;
+#else
+		return __builtin_ctz(x);
+#endif
+	}
+
+	inline int count_trailing_zeros(uint64_t x) {
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward64(&index, x);
+
+		return index;
+#else
+		return __builtin_ctzll(x);
+#endif
+	}
+};
@@ -9,6 +9,7 @@ namespace Constants {
 
 	// True number of N*M x N*M Sudoku grids, if known. 
 	// Source: https://en.wikipedia.org/wiki/Mathematics_of_Sudoku#Enumeration_results
+	// The totals up to 3x3 can be recomputed with count_exactly(), see ExactCount.h
 	template<int N, int M> inline BigInteger get_true_value();
 	template<> inline BigInteger get_true_value<2, 2>() { return BigInteger("288"); }
 	template<> inline BigInteger get_true_value<2, 3>() { return BigInteger("28200960"); }
@@ -27,7 +28,7 @@ namespace Constants {
 	template<> inline BigInteger get_reduced_latin_rectangle_count<2, 2>() { return 3; }																													// Number of Reduced 2x4  Latin Rectangles
 	template<> inline BigInteger get_reduced_latin_rectangle_count<2, 3>() { return 1064; }																													// Number of Reduced 3x6  Latin Rectangles
 	template<> inline BigInteger get_reduced_latin_rectangle_count<2, 4>() { return 420909504; }																											// Number of Reduced 4x8  Latin Rectangles
-	template<> inline BigInteger get_reduced_latin_rectangle_count<2, 5>() { return 746988383076286464ULL; }																								// Number of Reduced 5x10 Latin Rectangles
+	template<> inline BigInteger get_reduced_latin_rectangle_count<2, 5>() { return BigInteger("746988383076286464"); }																						// Number of Reduced 5x10 Latin Rectangles
 	template<> inline BigInteger get_reduced_latin_rectangle_count<2, 6>() { return BigInteger(1 << 17) * BigInteger(9 * 5 * 131) * BigInteger(110630813) * BigInteger(65475601447957); }					// Number of Reduced 6x12 Latin Rectangles
 	template<> inline BigInteger get_reduced_latin_rectangle_count<3, 3>() { return 103443808; }																											// Number of Reduced 3x9  Latin Rectangles
 	template<> inline BigInteger get_reduced_latin_rectangle_count<3, 4>() { return BigInteger(1 << 9) * BigInteger(27 * 7) * BigInteger(1945245990285863); }												// Number of Reduced 4x12 Latin Rectangles
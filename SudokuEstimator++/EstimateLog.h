@@ -0,0 +1,116 @@
+#pragma once
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <chrono>
+
+#include "FixedInteger.h"
+
+// Binary format of the results files.
+// A file starts with an EstimateLogHeader, followed by one record per estimate.
+// A record consists of 'limb_count' 64 bit limbs, least significant limb first.
+// Everything is stored little endian, which is the native byte order of the x86 and x64 targets this project builds for.
+// Since every record has the same size, a reader can map the file and index the records directly,
+// see 'Python Scripts/process_results.py'.
+namespace EstimateLog {
+	constexpr char     MAGIC[8] = { 'S', 'U', 'D', 'O', 'K', 'U', 'E', 'S' };
+	constexpr uint32_t VERSION  = 2;
+
+	struct Header {
+		char     magic[8];
+		uint32_t version;
+
+		uint32_t n;
+		uint32_t m;
+		uint32_t random_walk_length;
+
+		uint32_t sampler;    // Value of LatinRectangle::Sampler, which determines how the estimates should be scaled
+		uint32_t limb_count; // Number of limbs per record
+
+		uint64_t seed;         // Seed of the run, see Random.h
+		uint32_t thread_index; // Index of the thread that wrote the file, together with the seed this determines all estimates
+		uint32_t reserved;
+	};
+
+	static_assert(sizeof(Header) == 48, "Header layout should not contain any padding");
+
+	// Writes records to a results file through a large stdio buffer.
+	// The buffer is written out when it is full, at most every FLUSH_INTERVAL and when the writer is destroyed,
+	// so a run that is killed loses at most the last FLUSH_INTERVAL of estimates.
+	// Every thread writes to its own file, so no synchronization is needed.
+	// The estimates in a file are determined by the seed and thread index in its name, so an existing file is overwritten.
+	template<int LIMBS>
+	struct Writer {
+	private:
+		FILE * file = nullptr;
+
+		static constexpr int BUFFER_SIZE = 1 << 20;
+		char * buffer = nullptr;
+
+		static constexpr std::chrono::seconds FLUSH_INTERVAL = std::chrono::seconds(1);
+		std::chrono::steady_clock::time_point last_flush_time = std::chrono::steady_clock::now();
+
+	public:
+		inline Writer(const char * file_name, const Header & header) {
+			assert(header.limb_count == LIMBS);
+
+			buffer = new char[BUFFER_SIZE];
+
+#ifdef _WIN32
+			if (fopen_s(&file, file_name, "wb") != 0) file = nullptr;
+#else
+			file = fopen(file_name, "wb");
+#endif
+			if (file == nullptr) {
+				printf("Unable to open results file %s!\n", file_name);
+
+				abort();
+			}
+
+			setvbuf(file, buffer, _IOFBF, BUFFER_SIZE);
+
+			fwrite(&header, sizeof(Header), 1, file);
+		}
+
+		inline ~Writer() {
+			fclose(file);
+
+			delete[] buffer;
+		}
+
+		inline void append(const FixedInteger<LIMBS> & estimate) {
+			fwrite(estimate.limbs, sizeof(uint64_t), LIMBS, file);
+		}
+
+		// Hands the buffered records to the operating system if the last flush was more than FLUSH_INTERVAL ago
+		// Cheap enough to call after every batch, the clock is read but no system call is made otherwise
+		inline void flush_if_due() {
+			auto now = std::chrono::steady_clock::now();
+			if (now - last_flush_time < FLUSH_INTERVAL) return;
+
+			fflush(file);
+
+			last_flush_time = now;
+		}
+	};
+
+	inline Header make_header(int n, int m, int random_walk_length, uint32_t sampler, int limb_count, uint64_t seed, int thread_index) {
+		Header header;
+		memcpy(header.magic, MAGIC, sizeof(MAGIC));
+		header.version = VERSION;
+
+		header.n                  = n;
+		header.m                  = m;
+		header.random_walk_length = random_walk_length;
+
+		header.sampler    = sampler;
+		header.limb_count = limb_count;
+
+		header.seed         = seed;
+		header.thread_index = thread_index;
+		header.reserved     = 0;
+
+		return header;
+	}
+};
@@ -0,0 +1,431 @@
+#include "ExactCount.h"
+
+#include <map>
+#include <cstdio>
+#include <array>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <algorithm>
+
+#include "Bits.h"
+
+template<int N, int M>
+struct BandCounter {
+	static constexpr int size = N * M;
+
+	// Bands are N rows high and there are M of them, stacks are M columns wide and there are N of them
+	static constexpr int band_count = M;
+
+	static constexpr uint32_t all_values = (1u << size) - 1;
+
+	static_assert(size <= EXACT_COUNT_MAX_SIZE, "The exact counter only supports small Sudokus");
+
+	// Values that every column holds so far
+	using ColumnSets = std::array<uint32_t, size>;
+
+	// Column sets as the set of columns that hold every value, sorted, which makes them independent of the labels
+	using Key = std::array<uint16_t, size>;
+
+	// Column sets of the columns of a single stack in one band
+	using StackSets = std::array<uint32_t, M>;
+
+	// Orders of the stacks, and orders of the columns within a stack
+	std::vector<std::array<int, N>> stack_orders;
+	std::vector<std::array<int, M>> column_orders;
+
+	// Image of every subset of the columns of a stack under every column order
+	std::vector<std::array<uint16_t, 1 << M>> subset_images;
+
+	BandCounter() {
+		std::array<int, N> stacks;
+		for (int s = 0; s < N; s++) stacks[s] = s;
+
+		do {
+			stack_orders.push_back(stacks);
+		} while (std::next_permutation(stacks.begin(), stacks.end()));
+
+		std::array<int, M> columns;
+		for (int c = 0; c < M; c++) columns[c] = c;
+
+		do {
+			column_orders.push_back(columns);
+
+			std::array<uint16_t, 1 << M> images = { };
+
+			for (int subset = 0; subset < 1 << M; subset++) {
+				for (int c = 0; c < M; c++) {
+					if ((subset >> c) & 1) images[subset] |= 1u << columns[c];
+				}
+			}
+
+			subset_images.push_back(images);
+		} while (std::next_permutation(columns.begin(), columns.end()));
+	}
+
+	// Columns that hold every value, split up by stack
+	static void get_value_columns(const ColumnSets & column_sets, uint16_t (& value_columns)[N][size]) {
+		for (int s = 0; s < N; s++) {
+			for (int v = 0; v < size; v++) value_columns[s][v] = 0;
+
+			for (int c = 0; c < M; c++) {
+				uint32_t values = column_sets[s * M + c];
+
+				while (values) {
+					value_columns[s][Bits::count_trailing_zeros(values)] |= 1u << c;
+					values &= values - 1;
+				}
+			}
+		}
+	}
+
+	static void sort_key(Key & key) {
+		// Insertion sort, the key holds at most 9 elements
+		for (int i = 1; i < size; i++) {
+			uint16_t element = key[i];
+
+			int j = i;
+			for (; j > 0 && key[j - 1] > element; j--) key[j] = key[j - 1];
+			key[j] = element;
+		}
+	}
+
+	// Key that only removes the labels, equal keys are still equivalent, but equivalent column sets can get different keys
+	static Key get_label_key(const ColumnSets & column_sets) {
+		uint16_t value_columns[N][size];
+		get_value_columns(column_sets, value_columns);
+
+		Key key = { };
+
+		for (int s = 0; s < N; s++) {
+			for (int v = 0; v < size; v++) key[v] |= value_columns[s][v] << (s * M);
+		}
+
+		sort_key(key);
+
+		return key;
+	}
+
+	// Smallest label key over all orders of the stacks and of the columns within them, which is the same for all equivalent column sets.
+	// The contributions of the stacks are built up one stack at a time, so that every prefix of orders is only computed once.
+	Key get_key(const ColumnSets & column_sets) const {
+		uint16_t value_columns[N][size];
+		get_value_columns(column_sets, value_columns);
+
+		Key best;
+		best.fill(0xffff);
+
+		Key partial[N + 1];
+		partial[0] = { };
+
+		int order_indices[N];
+
+		for (const std::array<int, N> & stack_order : stack_orders) {
+			int s = 0;
+			order_indices[0] = 0;
+
+			while (s >= 0) {
+				if (order_indices[s] == (int)column_orders.size()) {
+					s--;
+					if (s >= 0) order_indices[s]++;
+
+					continue;
+				}
+
+				const std::array<uint16_t, 1 << M> & images = subset_images[order_indices[s]];
+
+				for (int v = 0; v < size; v++) {
+					partial[s + 1][v] = partial[s][v] | images[value_columns[s][v]] << (stack_order[s] * M);
+				}
+
+				if (s + 1 < N) {
+					s++;
+					order_indices[s] = 0;
+
+					continue;
+				}
+
+				Key key = partial[N];
+				sort_key(key);
+
+				if (key < best) best = key;
+
+				order_indices[s]++;
+			}
+		}
+
+		return best;
+	}
+
+	// Adds every way to split the values in 'unassigned' over the columns of a stack, such that every column ends up with N values
+	// and no column gets a value it already holds
+	static void enumerate_stack(const uint32_t * held, StackSets & sets, uint32_t unassigned, std::vector<StackSets> & result) {
+		if (unassigned == 0) {
+			result.push_back(sets);
+
+			return;
+		}
+
+		uint32_t bit = unassigned & (~unassigned + 1);
+
+		for (int c = 0; c < M; c++) {
+			if ((held[c] & bit) || Bits::popcount(sets[c]) == N) continue;
+
+			sets[c] |= bit;
+			enumerate_stack(held, sets, unassigned & ~bit, result);
+			sets[c] &= ~bit;
+		}
+	}
+
+	// Number of ways to fill in 'rows_left' rows of a band, where every column has to take the values that are left in its set.
+	// Every value is left in exactly 'rows_left' columns, one per stack, so this counts the ways to split the sets into rows that are permutations.
+	static uint64_t count_arrangements(uint32_t * left, int rows_left) {
+		if (rows_left == 1) return 1;
+
+		// With two values left in every column, every value connects the two columns it is left in, which forms cycles.
+		// Every cycle can be filled in in exactly two ways.
+		if (rows_left == 2) {
+			int parents[size];
+			for (int v = 0; v < size; v++) parents[v] = v;
+
+			auto find = [&](int v) {
+				while (parents[v] != v) v = parents[v] = parents[parents[v]];
+
+				return v;
+			};
+
+			int cycle_count = size;
+
+			for (int c = 0; c < size; c++) {
+				int a = find(Bits::count_trailing_zeros(left[c]));
+				int b = find(Bits::count_trailing_zeros(left[c] & (left[c] - 1)));
+
+				if (a != b) {
+					parents[a] = b;
+					cycle_count--;
+				}
+			}
+
+			return 1ull << cycle_count;
+		}
+
+		return count_rows(left, 0, all_values, rows_left);
+	}
+
+	// Picks a value for every column of the next row, columns with the fewest values left first
+	static uint64_t count_rows(uint32_t * left, uint32_t filled_columns, uint32_t row_values, int rows_left) {
+		if (filled_columns == all_values) return count_arrangements(left, rows_left - 1);
+
+		int      best_column = -1;
+		uint32_t best_values = 0;
+		int      best_count  = size + 1;
+
+		for (int c = 0; c < size; c++) {
+			if ((filled_columns >> c) & 1) continue;
+
+			uint32_t values = left[c] & row_values;
+			int      count  = Bits::popcount(values);
+
+			if (count < best_count) {
+				best_column = c;
+				best_values = values;
+				best_count  = count;
+
+				if (count == 0) return 0;
+			}
+		}
+
+		uint64_t total = 0;
+
+		while (best_values) {
+			uint32_t bit = best_values & (~best_values + 1);
+			best_values &= best_values - 1;
+
+			left[best_column] &= ~bit;
+			total += count_rows(left, filled_columns | (1u << best_column), row_values & ~bit, rows_left);
+			left[best_column] |= bit;
+		}
+
+		return total;
+	}
+
+	// Number of bands with the given column sets, with 'rows_left' of their rows still to be filled in
+	static uint64_t count_bands(const ColumnSets & sets, int rows_left) {
+		ColumnSets left = sets;
+
+		return count_arrangements(left.data(), rows_left);
+	}
+
+	// Calls 'f' with every column signature of the next band, 'first' holds values that the band already has in its first row
+	template<typename F>
+	static void for_each_band(const ColumnSets & held, const ColumnSets & first, F && f) {
+		std::vector<StackSets> stack_options[N];
+
+		for (int s = 0; s < N; s++) {
+			StackSets sets;
+			uint32_t  unassigned = all_values;
+
+			for (int c = 0; c < M; c++) {
+				sets[c]     = first[s * M + c];
+				unassigned &= ~sets[c];
+			}
+
+			enumerate_stack(held.data() + s * M, sets, unassigned, stack_options[s]);
+		}
+
+		// Combine the options of all stacks
+		ColumnSets band;
+		int        indices[N] = { };
+
+		while (true) {
+			for (int s = 0; s < N; s++) {
+				for (int c = 0; c < M; c++) band[s * M + c] = stack_options[s][indices[s]][c];
+			}
+
+			f(band);
+
+			int s = 0;
+			for (; s < N; s++) {
+				if (++indices[s] < (int)stack_options[s].size()) break;
+				indices[s] = 0;
+			}
+
+			if (s == N) break;
+		}
+	}
+
+	// Completed grids of the bands from 'band_index' onwards, given the values that the columns hold so far
+	// Later bands are memoized on their label key only, there are too many of them for the full key to pay off
+	static uint64_t count_completions(const ColumnSets & held, int band_index, std::map<Key, uint64_t> * memo) {
+		// The last band has to take exactly the values that are missing from every column
+		if (band_index == band_count - 1) {
+			ColumnSets sets;
+			for (int c = 0; c < size; c++) sets[c] = all_values & ~held[c];
+
+			return count_bands(sets, N);
+		}
+
+		// Classes of the first band are all different already
+		Key key;
+		if (band_index > 1) {
+			key = get_label_key(held);
+
+			auto it = memo[band_index].find(key);
+			if (it != memo[band_index].end()) return it->second;
+		}
+
+		uint64_t total = 0;
+
+		ColumnSets none = { };
+
+		for_each_band(held, none, [&](const ColumnSets & sets) {
+			ColumnSets next;
+			for (int c = 0; c < size; c++) next[c] = held[c] | sets[c];
+
+			// Swapping the last two bands maps every grid onto another one, so only the half where the column sets
+			// of the last band come after the ones of the band before it is counted
+			if (band_index == band_count - 2) {
+				ColumnSets last;
+				for (int c = 0; c < size; c++) last[c] = all_values & ~next[c];
+
+				if (last < sets) return;
+
+				uint64_t bands = count_bands(sets, N);
+				if (bands == 0) return;
+
+				total += 2 * bands * count_bands(last, N);
+			} else {
+				uint64_t bands = count_bands(sets, N);
+				if (bands == 0) return;
+
+				total += bands * count_completions(next, band_index + 1, memo);
+			}
+		});
+
+		if (band_index > 1) memo[band_index][key] = total;
+
+		return total;
+	}
+
+	BigInteger count(int thread_count) const {
+		struct EquivalenceClass {
+			ColumnSets representative;
+			uint64_t   band_count;   // Number of first bands in the class
+			uint64_t   completions;  // Number of ways to complete a single first band of the class
+		};
+
+		// The first row is fixed to 1..size, every grid is one of size! relabelings of a grid with that first row
+		ColumnSets first;
+		for (int c = 0; c < size; c++) first[c] = 1u << c;
+
+		ColumnSets none = { };
+
+		std::map<Key, int>            class_indices;
+		std::map<Key, int>            label_class_indices; // Many first bands only differ in their labels, their full key is computed once
+		std::vector<EquivalenceClass> classes;
+
+		for_each_band(none, first, [&](const ColumnSets & sets) {
+			// Only the rows below the fixed first row are left to arrange
+			ColumnSets left;
+			for (int c = 0; c < size; c++) left[c] = sets[c] & ~first[c];
+
+			uint64_t bands = count_bands(left, N - 1);
+			if (bands == 0) return;
+
+			auto label_inserted = label_class_indices.emplace(get_label_key(sets), 0);
+			if (label_inserted.second) {
+				auto inserted = class_indices.emplace(get_key(sets), (int)classes.size());
+				if (inserted.second) {
+					classes.push_back({ sets, 0, 0 });
+				}
+
+				label_inserted.first->second = inserted.first->second;
+			}
+
+			classes[label_inserted.first->second].band_count += bands;
+		});
+
+		printf("%zu column signature classes of the first band\n", classes.size());
+
+		// Threads take the next class that is left, every thread memoizes on its own
+		std::atomic<int> next_class(0);
+
+		auto work = [&]() {
+			std::map<Key, uint64_t> memo[band_count];
+
+			int i;
+			while ((i = next_class++) < (int)classes.size()) {
+				classes[i].completions = count_completions(classes[i].representative, 1, memo);
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (int t = 1; t < thread_count; t++) threads.emplace_back(work);
+
+		work();
+
+		for (std::thread & thread : threads) thread.join();
+
+		BigInteger total = 0;
+
+		for (const EquivalenceClass & equivalence_class : classes) {
+			total += BigIntegerMath::from_uint64(equivalence_class.band_count) * BigIntegerMath::from_uint64(equivalence_class.completions);
+		}
+
+		return total * BigIntegerMath::factorial(size);
+	}
+};
+
+template<int N, int M>
+BigInteger count_exactly(int thread_count) {
+	BandCounter<N, M> counter;
+
+	return counter.count(thread_count);
+}
+
+// Explicit instantiations for all sizes that the exact counter supports, these need to match the dispatch table in Main.cpp
+template BigInteger count_exactly<2, 2>(int thread_count);
+template BigInteger count_exactly<2, 3>(int thread_count);
+template BigInteger count_exactly<2, 4>(int thread_count);
+template BigInteger count_exactly<3, 3>(int thread_count);
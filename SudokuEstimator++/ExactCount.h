@@ -0,0 +1,14 @@
+#pragma once
+#include "BigInteger.h"
+
+// Largest N * M that count_exactly() supports, beyond 3x3 the number of equivalence classes and completions grows out of reach
+constexpr int EXACT_COUNT_MAX_SIZE = 9;
+
+// Counts all N*M x N*M Sudoku grids exactly, by enumerating the grid one band (N rows) at a time.
+// The number of ways to fill in the remaining bands only depends on which values every column already holds, its column signature,
+// and stays the same when the values are relabeled, the columns within a stack are permuted or the stacks are permuted.
+// First bands are grouped into these equivalence classes, and the completions of every class are counted once, spread over 'thread_count' threads.
+// Every band is enumerated by its column signature as well, weighted by the number of bands that have that signature.
+// The supported values of N and M are explicitly instantiated in ExactCount.cpp, they need N * M <= EXACT_COUNT_MAX_SIZE.
+template<int N, int M>
+BigInteger count_exactly(int thread_count);
@@ -0,0 +1,127 @@
+#pragma once
+#include <cstdint>
+#include <cassert>
+#include <cmath>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "BigInteger.h"
+
+// Unsigned integer of LIMBS 64 bit limbs, stored least significant limb first.
+// Used for the per sample estimates instead of BigInteger, since it lives on the stack and never allocates.
+// It only supports the operations the estimator needs, results are truncated to LIMBS limbs,
+// so LIMBS has to be chosen large enough that no estimate can overflow.
+template<int LIMBS>
+struct FixedInteger {
+	static_assert(LIMBS > 0, "FixedInteger needs at least one limb");
+
+	static constexpr int limb_count = LIMBS;
+
+	uint64_t limbs[LIMBS];
+
+	inline FixedInteger() { }
+
+	inline FixedInteger(uint64_t value) {
+		*this = value;
+	}
+
+	inline FixedInteger & operator=(uint64_t value) {
+		limbs[0] = value;
+
+		for (int i = 1; i < LIMBS; i++) {
+			limbs[i] = 0;
+		}
+
+		return *this;
+	}
+
+	inline FixedInteger & operator*=(uint64_t value) {
+		if (!multiply_checked(value)) {
+			assert(false); // Overflow
+		}
+
+		return *this;
+	}
+
+	// Same as operator*=, but returns false instead of asserting if the product did not fit in LIMBS limbs, it is truncated then
+	inline bool multiply_checked(uint64_t value) {
+		uint64_t carry = 0;
+
+		for (int i = 0; i < LIMBS; i++) {
+			uint64_t high;
+			uint64_t low = multiply(limbs[i], value, &high);
+
+			limbs[i] = low + carry;
+			carry    = high + (limbs[i] < low);
+		}
+
+		return carry == 0;
+	}
+
+	// Adds an integer with at most as many limbs
+	template<int OTHER_LIMBS>
+	inline FixedInteger & operator+=(const FixedInteger<OTHER_LIMBS> & other) {
+		static_assert(OTHER_LIMBS <= LIMBS, "Cannot add a wider FixedInteger");
+
+		uint64_t carry = 0;
+
+		for (int i = 0; i < LIMBS; i++) {
+			uint64_t sum = limbs[i] + carry;
+			carry = sum < carry;
+
+			if (i < OTHER_LIMBS) {
+				limbs[i] = sum + other.limbs[i];
+				carry   += limbs[i] < sum;
+			} else {
+				limbs[i] = sum;
+			}
+		}
+
+		assert(carry == 0); // Overflow
+
+		return *this;
+	}
+
+	inline bool is_zero() const {
+		for (int i = 0; i < LIMBS; i++) {
+			if (limbs[i] != 0) return false;
+		}
+
+		return true;
+	}
+
+	// Nearest double, used for statistics over the estimates
+	inline double to_double() const {
+		double result = 0.0;
+
+		for (int i = LIMBS - 1; i >= 0; i--) {
+			result = ldexp(result, 64) + (double)limbs[i];
+		}
+
+		return result;
+	}
+
+	// Promotes the integer to a BigInteger, this allocates and should be kept out of the hot path
+	inline BigInteger to_big_integer() const {
+		BigInteger result;
+		mpz_import(result.__get_mp(), LIMBS, -1, sizeof(uint64_t), 0, 0, limbs);
+
+		return result;
+	}
+
+private:
+	// Full 64 x 64 -> 128 bit multiplication, returns the low half and stores the high half in 'high'
+	inline static uint64_t multiply(uint64_t a, uint64_t b, uint64_t * high) {
+#ifdef _MSC_VER
+		return _umul128(a, b, high);
+#else
+		unsigned __int128 product = (unsigned __int128)a * b;
+
+		*high = (uint64_t)(product >> 64);
+
+		return (uint64_t)product;
+#endif
+	}
+};
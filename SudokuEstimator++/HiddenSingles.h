@@ -0,0 +1,108 @@
+#pragma once
+#include <cstdint>
+
+#include "Bits.h"
+
+// Compile time table of the units of the grid: every row, column and block, as lists of cell indices.
+// Every Nth row is always filled in by the Latin Rectangle, so those rows are left out.
+template<int N, int M>
+struct Units {
+	static constexpr int size  = N * M;
+	static constexpr int count = (size - M) + size + size; // Rows, columns and blocks
+
+	unsigned short cells[count][size];
+
+	constexpr Units() : cells() {
+		int unit = 0;
+
+		for (int y = 0; y < size; y++) {
+			if (y % N == 0) continue;
+
+			for (int x = 0; x < size; x++) cells[unit][x] = x + y * size;
+			unit++;
+		}
+
+		for (int x = 0; x < size; x++) {
+			for (int y = 0; y < size; y++) cells[unit][y] = x + y * size;
+			unit++;
+		}
+
+		for (int by = 0; by < size; by += N) {
+			for (int bx = 0; bx < size; bx += M) {
+				int length = 0;
+
+				for (int y = by; y < by + N; y++) {
+					for (int x = bx; x < bx + M; x++) cells[unit][length++] = x + y * size;
+				}
+				unit++;
+			}
+		}
+	}
+};
+
+template<int N, int M>
+inline constexpr Units<N, M> units;
+
+namespace HiddenSingles {
+	enum struct Result {
+		NONE,          // Every value that is missing from a unit can go in at least two of its cells
+		HIDDEN_SINGLE, // Some value that is missing from a unit can go in only one of its cells
+		DEAD_END       // Some value that is missing from a unit cannot go in any of its cells
+	};
+
+	// Looks for a value that only a single empty cell of its row, column or block can take.
+	// Every solution has to put the value in that cell, so the backtracker only has to branch on that one value.
+	// Computes the domains of all empty cells and scans all units, which costs more than the scan of MostConstrainedTraverser,
+	// so it should only be used when the traverser found no cell with a single value left.
+	template<int N, int M, typename SudokuType>
+	inline Result find(const SudokuType & sudoku, int & cell_index, int & value) {
+		constexpr int      size       = N * M;
+		constexpr uint32_t all_values = (1u << size) - 1;
+
+		// Every cell is in three units, so the domains are computed once up front
+		uint32_t domains[size * size];
+
+		for (int i = 0; i < sudoku.empty_cells_length; i++) {
+			int cell = sudoku.empty_cells[i];
+
+			domains[cell] = sudoku.get_domain_mask(cell);
+		}
+
+		for (int u = 0; u < Units<N, M>::count; u++) {
+			const unsigned short * cells = units<N, M>.cells[u];
+
+			uint32_t placed = 0; // Values of the filled in cells
+			uint32_t once   = 0; // Values that at least one empty cell can take
+			uint32_t twice  = 0; // Values that at least two empty cells can take
+
+			for (int i = 0; i < size; i++) {
+				int cell = cells[i];
+
+				if (sudoku.grid[cell] != 0) {
+					placed |= 1u << (sudoku.grid[cell] - 1);
+				} else {
+					twice |= once & domains[cell];
+					once  |= domains[cell];
+				}
+			}
+
+			if ((placed | once) != all_values) return Result::DEAD_END;
+
+			uint32_t singles = once & ~twice;
+
+			if (singles != 0) {
+				value = Bits::count_trailing_zeros(singles);
+
+				for (int i = 0; i < size; i++) {
+					cell_index = cells[i];
+
+					if (sudoku.grid[cell_index] == 0 && ((domains[cell_index] >> value) & 1)) break;
+				}
+
+				return Result::HIDDEN_SINGLE;
+			}
+		}
+
+		return Result::NONE;
+	}
+}
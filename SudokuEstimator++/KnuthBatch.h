@@ -0,0 +1,153 @@
+#pragma once
+#include <cstdint>
+
+#include "Bits.h"
+#include "Peers.h"
+#include "SIMDKernels.h"
+
+// The peers of every cell as offsets into KnuthBatch::domains, padded up to Peers<N, M>::max_count with the offset of the sink row,
+// so that all lanes can run over the same number of peers regardless of the cell they are at
+template<int N, int M, int LANES>
+struct BatchPeers {
+	static constexpr int size       = N * M;
+	static constexpr int cell_count = size * size;
+	static constexpr int max_count  = Peers<N, M>::max_count;
+
+	int offsets[cell_count][max_count];
+
+	constexpr BatchPeers() : offsets() {
+		for (int cell_index = 0; cell_index < cell_count; cell_index++) {
+			for (int k = 0; k < max_count; k++) {
+				int peer = k < peers<N, M>.count[cell_index] ? peers<N, M>.indices[cell_index][k] : cell_count;
+
+				offsets[cell_index][k] = peer * LANES;
+			}
+		}
+	}
+};
+
+template<int N, int M, int LANES>
+inline constexpr BatchPeers<N, M, LANES> batch_peers;
+
+// Domains of LANES independent grids in structure of arrays form, so that the random walks of LANES samples can take their steps together.
+// Only the domains are kept, as bitmasks, which is all the uniform random walk needs, and lanes are interleaved per cell.
+// Every step updates the peers of the live lanes one lane at a time, the batch saves work through the cheap bitmask updates
+// and because walks that die are never filled into a Sudoku, not through vector width.
+// After the walk, a lane that is still alive is turned back into a Sudoku by replaying its Latin Rectangle and walk.
+template<int N, int M, int LANES>
+struct KnuthBatch {
+	static constexpr int size       = N * M;
+	static constexpr int cell_count = size * size;
+
+	static constexpr uint32_t full_mask = (1u << size) - 1;
+
+	static_assert(LANES <= 32, "Lanes are tracked in 32 bit masks");
+
+	// Domain of cell c in lane l is at domains[c][l], the extra row is the sink of the padded peers.
+	// The sink has all bits above the values set, so it never becomes empty.
+	alignas(64) uint32_t domains[cell_count + 1][LANES];
+
+	// Sets the domains of a lane to the ones of a grid that only has the given Latin Rectangle filled in
+	inline void reset_lane(int lane, const int rows[M][size]) {
+		// Every empty cell sees the Latin Rectangle in its column and in the Latin row of its band
+		uint32_t column_used[size] = { };
+		uint32_t block_used [M][N] = { };
+
+		for (int row = 0; row < M; row++) {
+			for (int x = 0; x < size; x++) {
+				uint32_t bit = 1u << rows[row][x];
+
+				column_used[x]          |= bit;
+				block_used [row][x / M] |= bit;
+			}
+		}
+
+		for (int y = 0; y < size; y++) {
+			for (int x = 0; x < size; x++) {
+				domains[x + y * size][lane] = full_mask & ~(column_used[x] | block_used[y / N][x / M]);
+			}
+		}
+
+		domains[cell_count][lane] = ~full_mask;
+	}
+
+	// Removes the value of every lane from the domains of the peers of its cell, for the lanes in 'lanes'.
+	// Returns the lanes in which some domain became empty. Cells that are filled in keep their own value in their domain,
+	// since none of their peers can take it anymore, so only domains of empty cells can become empty.
+	inline uint32_t set_scalar(const int cells[LANES], const int values[LANES], uint32_t lanes) {
+		uint32_t emptied = 0;
+
+		while (lanes) {
+			int lane = Bits::count_trailing_zeros(lanes);
+			lanes &= lanes - 1;
+
+			const unsigned short * cell_peers = peers<N, M>.indices[cells[lane]];
+			int                    peer_count = peers<N, M>.count  [cells[lane]];
+
+			uint32_t bit = 1u << values[lane];
+
+			bool valid = true;
+
+			for (int i = 0; i < peer_count; i++) {
+				valid &= (domains[cell_peers[i]][lane] &= ~bit) != 0;
+			}
+
+			if (!valid) emptied |= 1u << lane;
+		}
+
+		return emptied;
+	}
+
+	TARGET_AVX512 uint32_t set_avx512(const int cells[LANES], const int values[LANES], uint32_t lanes) {
+		constexpr const BatchPeers<N, M, LANES> & table = batch_peers<N, M, LANES>;
+
+		const __m512i vector_max_count = _mm512_set1_epi32(Peers<N, M>::max_count);
+		const __m512i vector_one       = _mm512_set1_epi32(1);
+		const __m512i vector_lane_id   = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+		uint32_t emptied = 0;
+
+		for (int first_lane = 0; first_lane < LANES; first_lane += 16) {
+			__mmask16 active = (__mmask16)(lanes >> first_lane);
+			if (active == 0) continue;
+
+			__m512i cell  = _mm512_maskz_loadu_epi32(active, cells  + first_lane);
+			__m512i value = _mm512_maskz_loadu_epi32(active, values + first_lane);
+			__m512i bit   = _mm512_maskz_sllv_epi32(active, vector_one, value);
+
+			__m512i row  = _mm512_mullo_epi32(cell, vector_max_count);
+			__m512i lane = _mm512_add_epi32(vector_lane_id, _mm512_set1_epi32(first_lane));
+
+			__mmask16 lane_emptied = 0;
+
+			for (int k = 0; k < Peers<N, M>::max_count; k++) {
+				__m512i offset = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), active, _mm512_add_epi32(row, _mm512_set1_epi32(k)), &table.offsets[0][0], 4);
+				__m512i index  = _mm512_add_epi32(offset, lane);
+
+				__m512i domain = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), active, index, &domains[0][0], 4);
+				domain = _mm512_maskz_andnot_epi32(active, bit, domain);
+
+				_mm512_mask_i32scatter_epi32(&domains[0][0], active, index, domain, 4);
+
+				lane_emptied |= _mm512_mask_testn_epi32_mask(active, domain, domain);
+			}
+
+			emptied |= (uint32_t)lane_emptied << first_lane;
+		}
+
+		return emptied;
+	}
+
+	// Picks the kernel with the instruction set that Sudoku<N, M> uses, see SIMDKernels.h, so the scalar loop by default.
+	// The AVX-512 kernel runs over all peers of all 16 lanes, even once most lanes are dead, while the scalar loop only visits
+	// the peers of the live lanes. Also when it hands over to the scalar loop once fewer than 8 lanes are alive, a sample takes
+	// within 5% of the time of the scalar loop on 2x3 to 3x4, so it is only used with --kernels avx512 if use_simd_kernels is enabled.
+	// AVX2 has no scatters, so it uses the scalar loop as well
+	inline uint32_t set(const int cells[LANES], const int values[LANES], uint32_t lanes) {
+		if constexpr (use_simd_kernels && LANES % 16 == 0) {
+			if (SIMDKernels<N, M>::instruction_set == SIMD::InstructionSet::AVX512) return set_avx512(cells, values, lanes);
+		}
+
+		return set_scalar(cells, values, lanes);
+	}
+};
@@ -0,0 +1,126 @@
+#pragma once
+#include <algorithm>
+#include <random>
+#include <cstdint>
+
+#include "Bits.h"
+
+// Methods to obtain a random M x N*M Latin Rectangle, whose first row is always 0 .. N*M-1.
+// These rectangles are used to fill every Nth row of the Sudoku.
+namespace LatinRectangle {
+	enum struct Sampler {
+		REJECTION, // Uniformly distributed, obtained by shuffling rows until no column contains a value twice
+		SEQUENTIAL // Not uniformly distributed, but rejection free. Every sample comes with an importance weight
+	};
+
+	inline const char * get_name(Sampler sampler) {
+		switch (sampler) {
+			case Sampler::SEQUENTIAL: return "sequential";
+			default:                  return "rejection";
+		}
+	}
+
+	// Estimates of both samplers need to be scaled differently, so they are written to different results files
+	inline const char * get_file_suffix(Sampler sampler) {
+		switch (sampler) {
+			case Sampler::SEQUENTIAL: return "_sequential";
+			default:                  return "";
+		}
+	}
+
+	// Fills 'rows' with a uniformly distributed Latin Rectangle
+	// Shuffles every row but the first one, and starts over as soon as a column contains a value twice
+	template<int N, int M, typename RNG>
+	void sample_rejection(int rows[M][N * M], RNG & rng) {
+		constexpr int size = N * M;
+
+		// Initialize each row of the Latin Rectangle with the numbers 1 .. N*M
+		for (int row = 0; row < M; row++) {
+			for (int i = 0; i < size; i++) {
+				rows[row][i] = i;
+			}
+		}
+
+		// Repeat until a valid Latin Rectangle is obtained
+		retry: {
+			// Randomly shuffle every row but the first one
+			for (int row = 1; row < M; row++) {
+				std::shuffle(rows[row], rows[row] + size, rng);
+
+				// Check if the current permutation of rows is still a Latin Rectangle
+				for (int i = 0; i < size; i++) {
+					for (int j = 0; j < row; j++) {
+						if (rows[row][i] == rows[j][i]) {
+							// Not a valid Latin Rectangle, retry
+							goto retry;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// Fills 'rows' with a Latin Rectangle, one cell at a time, like Knuth's algorithm does for the rest of the grid.
+	// In every row the column with the fewest remaining values is filled in next, with a value chosen uniformly from those values.
+	// The number of choices of every cell is multiplied into 'weight'. The resulting weight is the inverse of the probability
+	// that this rectangle was sampled, so weighting a sample by it gives an unbiased estimate over all Latin Rectangles
+	// with the same first row, just like the estimate of Knuth's algorithm.
+	// Returns false if a column ran out of values, in which case the rectangle has no weight at all.
+	template<int N, int M, typename Integer, typename RNG>
+	bool sample_sequential(int rows[M][N * M], Integer & weight, RNG & rng) {
+		constexpr int size = N * M;
+		constexpr uint32_t full_mask = (1u << size) - 1;
+
+		uint32_t column_used[size];
+
+		for (int i = 0; i < size; i++) {
+			rows[0][i] = i;
+
+			column_used[i] = 1u << i;
+		}
+
+		for (int row = 1; row < M; row++) {
+			uint32_t row_used      = 0;
+			uint32_t columns_empty = full_mask;
+
+			for (int step = 0; step < size; step++) {
+				// Find the most constrained column in the current row
+				int      column      = -1;
+				int      column_size = size + 1;
+				uint32_t column_mask = 0;
+
+				for (uint32_t empty = columns_empty; empty; empty &= empty - 1) {
+					int i = Bits::count_trailing_zeros(empty);
+
+					uint32_t mask = full_mask & ~(row_used | column_used[i]);
+					int      mask_size = Bits::popcount(mask);
+
+					if (mask_size < column_size) {
+						column      = i;
+						column_size = mask_size;
+						column_mask = mask;
+					}
+				}
+
+				if (column_size == 0) return false;
+
+				weight *= column_size;
+
+				// Pick a random value from the remaining values of the column
+				for (int skip = rng.bounded(column_size); skip > 0; skip--) {
+					column_mask &= column_mask - 1;
+				}
+
+				int value = Bits::count_trailing_zeros(column_mask);
+
+				rows[row][column] = value;
+
+				row_used            |= 1u << value;
+				column_used[column] |= 1u << value;
+				columns_empty       &= ~(1u << column);
+			}
+		}
+
+		return true;
+	}
+};
@@ -1,70 +1,330 @@
 #include <thread>
+#include <cstring>
+#include <filesystem>
 
 #include "SudokuEstimator.h"
+#include "Topology.h"
+#include "Benchmark.h"
+#include "Tuning.h"
+#include "ExactCount.h"
+#include "Constants.h"
+#include "ScopedTimer.h"
 
-#define VC_EXTRALEAN
-#define WIN32_LEAN_AND_MEAN
-#include <windows.h>
+std::vector<Topology::Worker> workers; // Logical processors of every estimator thread
 
-int thread_count;			// Number of Logical Processors
-int threads_per_processor;
+SIMD::InstructionSet instruction_set = SIMD::InstructionSet::SCALAR; // Instruction set used by the update kernels
 
-int     processor_count = 0;	// Number of Physical Processors
-ULONG * processor_masks;		// Stores the mask of each Physical Processor
+uint64_t seed; // All random streams of all threads are derived from this seed
 
-void create_and_run_estimator(int thread_index) {
-	// Set the Thread Affinity to two logical cores that belong to the same physical core
-	HANDLE thread = GetCurrentThread(); 
+bool tune = false; // Whether the random walk length is tuned with pilot samples before the estimators start
 
-	DWORD_PTR thread_affinity_mask     = processor_masks[thread_index / threads_per_processor];
-	DWORD_PTR thread_affinity_mask_old = SetThreadAffinityMask(thread, thread_affinity_mask);
+double target_precision = 0.0; // Relative half width of the 95% confidence interval at which the run stops, 0 to run forever
 
-	// Check validity of Thread Affinity
-    if ((thread_affinity_mask & thread_affinity_mask_old) == 0) {
-		printf("Unable to set Process Affinity Mask!\n");
+template<int N, int M>
+void create_and_run_estimator(int thread_index, int random_walk_length, typename SudokuEstimator<N, M>::Results * results, typename SudokuEstimator<N, M>::Subtrees * subtrees) {
+	// Restrict the thread to the processors it was placed on
+	if (!Topology::pin_current_thread(workers[thread_index])) {
+		printf("Unable to set the affinity of worker %u!\n", thread_index);
 
 		abort();
 	}
 
 	// Run the simulator
-	SudokuEstimator estimator;
-	estimator.run(thread_index);
+	SudokuEstimator<N, M> estimator(random_walk_length);
+	estimator.run(&results[thread_index], subtrees, seed, thread_index);
 }
 
-int main() {
-	// Ensure there is a Results folder, otherwise the program will crash
-	DWORD attrib = GetFileAttributes(L"./Results");
-	if (attrib == INVALID_FILE_ATTRIBUTES || !(attrib & FILE_ATTRIBUTE_DIRECTORY)) {
-		CreateDirectory(L"./Results", nullptr);
+// Starts an estimator for every logical processor, and reports their results on the calling thread
+template<int N, int M>
+void run_estimators(int random_walk_length) {
+	SIMDKernels<N, M>::instruction_set = instruction_set;
+
+	assert((Sudoku<N, M>::verify_kernels(instruction_set)));
+
+	printf("Using %s update kernels\n", SIMD::get_name(instruction_set));
+
+	if (tune) {
+		random_walk_length = tune_random_walk_length<N, M>(random_walk_length, seed);
 	}
-	
-	// Acquire logical core count of this machine
-	thread_count = std::thread::hardware_concurrency();
-	if (thread_count == 0) {
-		printf("Something went wrong when attempting to determine the number of cores on this machine!\n");
 
-		abort();
+	int thread_count = workers.size();
+
+	// Every thread publishes its results in its own slot
+	auto results = new typename SudokuEstimator<N, M>::Results[thread_count];
+
+	// Large residual grids are shared between the threads, which only makes sense if there is more than one
+	auto subtrees = thread_count > 1 ? new typename SudokuEstimator<N, M>::Subtrees(thread_count) : nullptr;
+
+	std::vector<std::thread> threads;
+
+	for (int i = 0; i < thread_count; i++) {
+		threads.emplace_back(create_and_run_estimator<N, M>, i, random_walk_length, results, subtrees);
+	}
+
+	// Run function on the main thread that prints the results of all the other threads to the console
+	// It only returns once the target precision is reached and the threads were told to stop
+	report_results<N, M>(random_walk_length, results, thread_count, target_precision);
+
+	for (std::thread & thread : threads) {
+		thread.join();
+	}
+
+	delete subtrees;
+	delete[] results;
+}
+
+// Runs the benchmarks on the calling thread instead of starting the estimators
+template<int N, int M>
+void run_benchmarks(int random_walk_length) {
+	SIMDKernels<N, M>::instruction_set = instruction_set;
+
+	run_benchmark<N, M>(random_walk_length);
+}
+
+// Counts all grids of the size exactly and compares the result with the known total
+template<int N, int M>
+void run_exact_count(int thread_count) {
+	printf("Counting all %ux%u Sudokus exactly on %u threads\n", N, M, thread_count);
+
+	BigInteger count;
+	{
+		ScopedTimer timer("Exact count");
+
+		count = count_exactly<N, M>(thread_count);
+	}
+
+	BigInteger true_value = Constants::get_true_value<N, M>();
+
+	printf("%ux%u: %s, %s\n", N, M, count.get_str().c_str(), count == true_value ? "matches the known total" : "DOES NOT match the known total!");
+}
+
+// Only the sizes up to EXACT_COUNT_MAX_SIZE have an exact counter
+template<int N, int M>
+constexpr void (* get_exact_count())(int thread_count) {
+	if constexpr (N * M <= EXACT_COUNT_MAX_SIZE) {
+		return run_exact_count<N, M>;
+	} else {
+		return nullptr;
+	}
+}
+
+// Every supported Sudoku size has its own fully specialized estimator, the size is selected at startup using this table.
+// The default random walk lengths fill in about 28% of the cells that are not part of the Latin Rectangle,
+// which is what s = 55 amounts to for 4x4.
+struct SudokuSize {
+	int n;
+	int m;
+
+	int default_random_walk_length;
+	int max_random_walk_length;
+
+	void (* run)        (int random_walk_length);
+	void (* benchmark)  (int random_walk_length);
+	void (* exact_count)(int thread_count); // nullptr if the size is too large to count exactly
+};
+
+template<int N, int M>
+constexpr SudokuSize make_size(int default_random_walk_length) {
+	return { N, M, default_random_walk_length, SudokuEstimator<N, M>::coordinate_count, run_estimators<N, M>, run_benchmarks<N, M>, get_exact_count<N, M>() };
+}
+
+constexpr SudokuSize sudoku_sizes[] = {
+	make_size<2, 2>(2),
+	make_size<2, 3>(7),
+	make_size<2, 4>(14),
+	make_size<3, 3>(15),
+	make_size<3, 4>(28),
+	make_size<4, 4>(55)
+};
+
+void print_usage(const char * program_name) {
+	printf("Usage: %s [--size NxM] [--s random_walk_length] [--kernels auto|scalar|avx2|avx512] [--placement core|smt|numa] [--seed seed] [--tune] [--precision p] [--benchmark] [--exact]\n", program_name);
+	printf("--tune picks the random walk length around --s that needs the least CPU time for a given precision, using pilot samples\n");
+	printf("--precision stops once the approximate 95%% confidence interval is within a fraction p of the average, for example 0.01 for +-1%%\n");
+	printf("--benchmark times the individual steps of the estimator, for the given size or for all sizes with their default --s if no size is given\n");
+	printf("--exact counts all grids exactly instead of estimating, for the given size or for all small enough sizes if no size is given\n");
+	printf("Supported sizes:");
+
+	for (const SudokuSize & size : sudoku_sizes) {
+		printf(" %ux%u", size.n, size.m);
+	}
+
+	printf("\n");
+}
+
+int main(int argc, char ** argv) {
+	int n = 4;
+	int m = 4;
+	int random_walk_length = -1;
+
+	Topology::Policy placement_policy = Topology::Policy::SMT;
+
+	bool size_given = false;
+	bool seed_given = false;
+	bool benchmark  = false;
+	bool exact      = false;
+
+	// Parse command line options
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+			if (sscanf(argv[++i], "%dx%d", &n, &m) != 2) {
+				print_usage(argv[0]);
+
+				return 1;
+			}
+
+			size_given = true;
+		} else if (strcmp(argv[i], "--s") == 0 && i + 1 < argc) {
+			random_walk_length = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "--kernels") == 0 && i + 1 < argc) {
+			if (!SIMD::parse_instruction_set(argv[++i], &instruction_set)) {
+				printf("Unknown instruction set '%s', expected one of: auto, scalar, avx2, avx512\n", argv[i]);
+
+				return 1;
+			}
+
+			if (instruction_set > SIMD::detect_instruction_set()) {
+				printf("Instruction set %s is not supported on this machine!\n", SIMD::get_name(instruction_set));
+
+				return 1;
+			}
+
+			// Without the SIMD kernels "auto" falls back to the scalar code, see use_simd_kernels in SIMDKernels.h
+			if (!use_simd_kernels && instruction_set != SIMD::InstructionSet::SCALAR) {
+				if (strcmp(argv[i], "auto") != 0) {
+					printf("The %s kernels are not compiled in, enable use_simd_kernels in SIMDKernels.h to use them\n", SIMD::get_name(instruction_set));
+
+					return 1;
+				}
+
+				instruction_set = SIMD::InstructionSet::SCALAR;
+			}
+		} else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+			seed       = strtoull(argv[++i], nullptr, 10);
+			seed_given = true;
+		} else if (strcmp(argv[i], "--precision") == 0 && i + 1 < argc) {
+			target_precision = atof(argv[++i]);
+
+			if (target_precision <= 0.0) {
+				printf("The precision should be a positive fraction, for example 0.01 for +-1%%\n");
+
+				return 1;
+			}
+		} else if (strcmp(argv[i], "--tune") == 0) {
+			tune = true;
+		} else if (strcmp(argv[i], "--benchmark") == 0) {
+			benchmark = true;
+		} else if (strcmp(argv[i], "--exact") == 0) {
+			exact = true;
+		} else if (strcmp(argv[i], "--placement") == 0 && i + 1 < argc) {
+			if (!Topology::parse_policy(argv[++i], &placement_policy)) {
+				printf("Unknown placement policy '%s', expected one of: core, smt, numa\n", argv[i]);
+
+				return 1;
+			}
+		} else {
+			print_usage(argv[0]);
+
+			return 1;
+		}
 	}
 
-	processor_masks = new ULONG[thread_count];
+	// Look up the selected size in the dispatch table
+	const SudokuSize * size = nullptr;
 
-	SYSTEM_LOGICAL_PROCESSOR_INFORMATION info[64];
-	DWORD buffer_length = 64 * sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION);
-	GetLogicalProcessorInformation(info, &buffer_length);
-	
-	// Count the number of physical cores and store their thread masks
-	for (int i = 0; i < buffer_length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION); i++) {
-		if (info[i].Relationship == LOGICAL_PROCESSOR_RELATIONSHIP::RelationProcessorCore) {
-			processor_masks[processor_count++] = info[i].ProcessorMask;
+	for (const SudokuSize & sudoku_size : sudoku_sizes) {
+		if (sudoku_size.n == n && sudoku_size.m == m) {
+			size = &sudoku_size;
 		}
 	}
 
-	threads_per_processor = thread_count / processor_count;
+	if (size == nullptr) {
+		printf("Unsupported Sudoku size %ux%u!\n", n, m);
+		print_usage(argv[0]);
 
-	for (int i = 0; i < thread_count; i++) {
-		std::thread(create_and_run_estimator, i).detach();
+		return 1;
 	}
 
-	// Run function on the main thread that prints the results of all the other threads to the console
-	report_results();
-}
\ No newline at end of file
+	// Without --size every size is benchmarked with its own default random walk length, so a given --s would be ignored
+	if (benchmark && !size_given && random_walk_length != -1) {
+		printf("--s can only be given together with --size when benchmarking!\n");
+
+		return 1;
+	}
+
+	if (random_walk_length == -1) {
+		random_walk_length = size->default_random_walk_length;
+	} else if (random_walk_length < 0 || random_walk_length > size->max_random_walk_length) {
+		printf("The random walk length for a %ux%u Sudoku should be between 0 and %u!\n", n, m, size->max_random_walk_length);
+
+		return 1;
+	}
+
+	if (benchmark) {
+		// Keep the benchmark on a single processor, so that it does not migrate while being timed
+		std::vector<Topology::LogicalProcessor> processors = Topology::detect();
+		if (!processors.empty()) {
+			Topology::pin_current_thread({ { processors[0].id } });
+		}
+
+		if (size_given) {
+			size->benchmark(random_walk_length);
+		} else {
+			for (const SudokuSize & sudoku_size : sudoku_sizes) {
+				sudoku_size.benchmark(sudoku_size.default_random_walk_length);
+			}
+		}
+
+		return 0;
+	}
+
+	if (exact) {
+		if (size_given && size->exact_count == nullptr) {
+			printf("%ux%u Sudokus are too large to count exactly!\n", n, m);
+
+			return 1;
+		}
+
+		// The equivalence classes are spread over as many threads as the estimators would get
+		std::vector<Topology::LogicalProcessor> processors = Topology::detect();
+
+		int thread_count = processors.empty() ? 1 : (int)Topology::place_workers(processors, placement_policy, Topology::get_cpu_quota()).size();
+
+		if (size_given) {
+			size->exact_count(thread_count);
+		} else {
+			for (const SudokuSize & sudoku_size : sudoku_sizes) {
+				if (sudoku_size.exact_count != nullptr) sudoku_size.exact_count(thread_count);
+			}
+		}
+
+		return 0;
+	}
+
+	// Without a given seed, pick a random one. It is printed so that the run can be reproduced
+	if (!seed_given) {
+		std::random_device random_device;
+		seed = (uint64_t)random_device() << 32 | random_device();
+	}
+
+	printf("Using seed %llu\n", (unsigned long long)seed);
+
+	// Ensure there is a Results folder, otherwise the program will crash
+	std::filesystem::create_directory("Results");
+
+	// Decide how many estimator threads to start, and where
+	std::vector<Topology::LogicalProcessor> processors = Topology::detect();
+	if (processors.empty()) {
+		printf("Something went wrong when attempting to determine the processors of this machine!\n");
+
+		abort();
+	}
+
+	int cpu_quota = Topology::get_cpu_quota();
+
+	workers = Topology::place_workers(processors, placement_policy, cpu_quota);
+
+	Topology::print_placement(processors, workers, placement_policy, cpu_quota);
+
+	size->run(random_walk_length);
+}
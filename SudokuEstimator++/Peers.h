@@ -0,0 +1,53 @@
+#pragma once
+
+// Compile time table of the cells whose domains are updated when a value is placed in a given cell.
+// The cells are the same as the ones updated by the generated code: the whole row of the cell, and the column and block
+// of the cell except for every Nth row, since those rows are always filled in by the Latin Rectangle.
+// The peers of every cell are stored in ascending order of cell index.
+template<int N, int M>
+struct Peers {
+	static constexpr int size = N * M;
+
+	// Upper bound on the amount of peers of a single cell
+	static constexpr int max_count = 2 * (size - 1) + (N - 1) * (M - 1);
+
+	int            count  [size * size];
+	unsigned short indices[size * size][max_count];
+
+	constexpr Peers() : count(), indices() {
+		for (int y = 0; y < size; y++) {
+			for (int x = 0; x < size; x++) {
+				int cell_index = x + y * size;
+
+				int bx = M * (x / M);
+				int by = N * (y / N);
+
+				int length = 0;
+
+				for (int j = 0; j < size; j++) {
+					if (j == y) {
+						// Current row
+						for (int i = 0; i < size; i++) {
+							if (i != x) indices[cell_index][length++] = i + j * size;
+						}
+					} else if (j % N != 0) {
+						if (j >= by && j < by + N) {
+							// Current block, which includes the current column
+							for (int i = bx; i < bx + M; i++) {
+								indices[cell_index][length++] = i + j * size;
+							}
+						} else {
+							// Current column
+							indices[cell_index][length++] = x + j * size;
+						}
+					}
+				}
+
+				count[cell_index] = length;
+			}
+		}
+	}
+};
+
+template<int N, int M>
+inline constexpr Peers<N, M> peers;
@@ -0,0 +1,130 @@
+#pragma once
+#include <cstdint>
+
+#include "Bits.h"
+#include "Peers.h"
+
+// Proposal distributions for the values that Knuth's algorithm picks in every step of the random walk.
+// If value v is picked with probability p(v), the estimate is multiplied by 1 / p(v), which keeps it unbiased
+// as long as every value that can still lead to a solution has p(v) > 0.
+// The proposals assign integer weights w(v), so 1 / p(v) = W / w(v) with W the sum of the weights. This is generally not an
+// integer, so it is rounded up with probability (W mod w(v)) / w(v) and down otherwise, which keeps the expectation exact.
+namespace Knuth {
+	enum struct Proposal {
+		UNIFORM,     // Every value in the domain is equally likely, the estimate is multiplied by the domain size
+		VIABLE,      // Uniform over the values that do not empty the domain of an empty peer
+		PEER_DOMAINS // Like VIABLE, but a value is weighted by how much it shrinks the domains of the empty peers
+	};
+
+	inline const char * get_name(Proposal proposal) {
+		switch (proposal) {
+			case Proposal::VIABLE:       return "viable";
+			case Proposal::PEER_DOMAINS: return "peer domains";
+			default:                     return "uniform";
+		}
+	}
+
+	// Weights are fixed point numbers with WEIGHT_BITS fractional bits. At most 16 values of at most 1 << WEIGHT_BITS
+	// sum to at most 1 << 16, the largest range that Random::Generator::bounded() accepts
+	constexpr int      WEIGHT_BITS = 12;
+	constexpr uint32_t WEIGHT_ONE  = 1u << WEIGHT_BITS;
+
+	// Factor (d - 1) / d by which the product of the domain sizes of the peers changes for a peer with a domain of size d,
+	// when one of its values is taken away
+	template<int size>
+	struct ShrinkFactors {
+		uint32_t factors[size + 1];
+
+		constexpr ShrinkFactors() : factors() {
+			for (int d = 1; d <= size; d++) {
+				factors[d] = (WEIGHT_ONE * (d - 1) + d / 2) / d;
+			}
+		}
+	};
+
+	template<int size>
+	inline constexpr ShrinkFactors<size> shrink_factors;
+
+	// Computes the weight of every value in 'domain' for the given cell, and returns the sum of the weights
+	// A value that empties the domain of an empty peer can never lead to a solution, and gets a weight of 0
+	// If the sum is 0, none of the values can lead to a solution
+	// Every other value gets a weight of at least W / domain_size, so that W / w(v) is at most 2 * domain_size, see SudokuEstimator::estimate_bit_count
+	template<int N, int M, Proposal proposal, typename SudokuType>
+	inline uint32_t get_weights(const SudokuType & sudoku, int cell_index, const int * domain, int domain_size, uint32_t * weights) {
+		constexpr int size = N * M;
+
+		const unsigned short * cell_peers = peers<N, M>.indices[cell_index];
+		int                    peer_count = peers<N, M>.count  [cell_index];
+
+		uint32_t cell_mask = 0;
+		for (int i = 0; i < domain_size; i++) cell_mask |= 1u << domain[i];
+
+		uint32_t excluded = 0; // Values that would empty the domain of a peer
+
+		uint32_t value_weights[size];
+
+		if constexpr (proposal == Proposal::PEER_DOMAINS) {
+			for (int i = 0; i < domain_size; i++) value_weights[domain[i]] = WEIGHT_ONE;
+		}
+
+		for (int j = 0; j < peer_count; j++) {
+			int peer = cell_peers[j];
+
+			if (sudoku.grid[peer] != 0) continue;
+
+			int peer_domain_size = sudoku.get_domain_size(peer);
+
+			if (peer_domain_size == 1) {
+				excluded |= sudoku.get_domain_mask(peer);
+			} else if constexpr (proposal == Proposal::PEER_DOMAINS) {
+				uint32_t factor = shrink_factors<size>.factors[peer_domain_size];
+
+				uint32_t shared = sudoku.get_domain_mask(peer) & cell_mask;
+
+				while (shared) {
+					uint32_t & weight = value_weights[Bits::count_trailing_zeros(shared)];
+
+					// Every value that can lead to a solution keeps a weight of at least 1
+					weight = (weight * factor) >> WEIGHT_BITS;
+					weight += weight == 0;
+
+					shared &= shared - 1;
+				}
+			}
+		}
+
+		uint32_t total = 0;
+
+		for (int i = 0; i < domain_size; i++) {
+			int value = domain[i];
+
+			uint32_t weight;
+			if ((excluded >> value) & 1) {
+				weight = 0;
+			} else if constexpr (proposal == Proposal::PEER_DOMAINS) {
+				weight = value_weights[value];
+			} else {
+				weight = 1; // Viable values all get the same weight
+			}
+
+			weights[i] = weight;
+			total     += weight;
+		}
+
+		if constexpr (proposal == Proposal::PEER_DOMAINS) {
+			// With a floor of m = ceil(W / domain_size) the new sum is at most W + domain_size * m,
+			// so W / w(v) stays at most W / m + domain_size <= 2 * domain_size. The floor is at most the largest weight.
+			uint32_t min_weight = (total + domain_size - 1) / domain_size;
+
+			total = 0;
+
+			for (int i = 0; i < domain_size; i++) {
+				if (weights[i] != 0 && weights[i] < min_weight) weights[i] = min_weight;
+
+				total += weights[i];
+			}
+		}
+
+		return total;
+	}
+};
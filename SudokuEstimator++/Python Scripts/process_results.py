@@ -2,6 +2,9 @@ import matplotlib
 import matplotlib.pyplot as plt
 import numpy as np
 import math
+import os
+import glob
+import struct
 
 N                  = int(input('Enter N: '))
 M                  = int(input('Enter M: '))
@@ -33,38 +36,55 @@ latin_rectangle_counts = {
     (4, 4): (1 << 14) * 243 * 2693 * 42787 * 1699482467 * 8098773443
 }
 
-file_path = '../Results/results_{}x{}_s={}.txt'.format(N, M, random_walk_length)
 # Change these values based on the Sudoku size
 latin_rectangle_count = reduced_factor(M, N * M) * latin_rectangle_counts[(N, M)]
 true_sudoku_count     = true_sudoku_counts[(N, M)]
 
-print('Reading file...')
+# Layout of the header at the start of every results file, see EstimateLog.h
+HEADER_FORMAT = '<8sIIIIIIQII'
+HEADER_SIZE   = struct.calcsize(HEADER_FORMAT)
 
-estimates = []
+SAMPLER_REJECTION  = 0
+SAMPLER_SEQUENTIAL = 1
 
-# Load a results file line by line and store it in the array 'estimates'
-with open(file_path) as file:
-   line = file.readline()
-   while line:
-       estimates.append(int(line))
-       line = file.readline()
+# Maps a results file without copying it, returns the header and an array with one row of limbs per estimate
+def read_results_file(file_path):
+    with open(file_path, 'rb') as file:
+        magic, version, n, m, s, sampler, limb_count, seed, thread_index, reserved = struct.unpack(HEADER_FORMAT, file.read(HEADER_SIZE))
 
-print('Transforming estimates...')
+    if magic != b'SUDOKUES' or version != 2:
+        raise ValueError('{} is not a version 2 results file'.format(file_path))
+
+    if os.path.getsize(file_path) == HEADER_SIZE:
+        return (n, m, s, sampler), np.zeros((0, limb_count), dtype='<u8')
+
+    records = np.memmap(file_path, dtype='<u8', mode='r', offset=HEADER_SIZE)
+    records = records[:len(records) - len(records) % limb_count].reshape(-1, limb_count) # Drop a partially written record at the end
+
+    return (n, m, s, sampler), records
 
 cumulative_sum = 0
 n = 0
 
 running_average = []
 
-# Multiply each estimate with the number of M x N*M Latin Rectangles
-# Calculate the running average of these estimates
-for estimate in estimates:
-    total_estimate = estimate * latin_rectangle_count
+# Every thread writes its own results file, process them one after the other
+for file_path in sorted(glob.glob('../Results/results_{}x{}_s={}_*.bin'.format(N, M, random_walk_length))):
+    print('Reading {}...'.format(file_path))
+
+    (file_n, file_m, file_s, sampler), records = read_results_file(file_path)
+    assert (file_n, file_m, file_s) == (N, M, random_walk_length)
+
+    # Multiply each estimate with the number of M x N*M Latin Rectangles,
+    # estimates of the sequential sampler already include the number of Latin Rectangles with a fixed first row
+    scale = math.factorial(N * M) if sampler == SAMPLER_SEQUENTIAL else latin_rectangle_count
 
-    cumulative_sum += total_estimate
-    n += 1
+    # Calculate the running average of these estimates
+    for record in records:
+        cumulative_sum += int.from_bytes(record.tobytes(), 'little') * scale
+        n += 1
 
-    running_average.append(cumulative_sum / n)
+        running_average.append(cumulative_sum / n)
 
 print('Sample count: {}'.format(n))
 
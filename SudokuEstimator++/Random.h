@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+#include <cassert>
+#include <utility>
+
+// Counter based random number generation.
+// The n-th output of a stream is a hash of the stream key and n, so a stream is fully described by its key and
+// a position in it, and a new stream costs nothing to create. This is used to give every thread and every batch
+// its own independent stream, derived from a single seed, which makes runs reproducible.
+namespace Random {
+	// Finalizer of SplitMix64, a bijective mix of the bits of x, constexpr so it can also fill compile time tables
+	constexpr uint64_t mix(uint64_t x) {
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+		return x ^ (x >> 31);
+	}
+
+	// Derives the key of the stream of a given batch of a given thread, different inputs give unrelated keys
+	inline uint64_t derive_key(uint64_t seed, uint64_t thread_index, uint64_t batch_index) {
+		return mix(mix(mix(seed) + thread_index) + batch_index);
+	}
+
+	// SplitMix64, used as a counter based generator: the n-th output is mix(key + n * GOLDEN_GAMMA).
+	// Meets the requirements of a UniformRandomBitGenerator, so it can be used with std::shuffle and the std distributions.
+	struct Generator {
+		using result_type = uint64_t;
+
+		static constexpr uint64_t GOLDEN_GAMMA = 0x9e3779b97f4a7c15ull;
+
+		uint64_t key     = 0;
+		uint64_t counter = 0;
+
+		// Unused 16 bit chunks of the last output, consumed by bounded()
+		uint64_t pool      = 0;
+		int      pool_size = 0;
+
+		inline Generator() { }
+		inline Generator(uint64_t key) : key(key), counter(0), pool(0), pool_size(0) { }
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return UINT64_MAX; }
+
+		inline result_type operator()() {
+			return mix(key + ++counter * GOLDEN_GAMMA);
+		}
+
+		// Uniformly distributed integer in [0, range), using Lemire's multiply and shift method.
+		// The random walk only needs small ranges, so every 64 bit output is split into four 16 bit chunks,
+		// which only need to be rejected with a probability of range / 2^16.
+		inline int bounded(int range) {
+			assert(range > 0 && range <= (1 << 16));
+
+			if (range == 1) return 0; // Common for domains in the random walk, no need to spend any bits on it
+
+			uint32_t product = next_chunk() * (uint32_t)range;
+			uint16_t low     = (uint16_t)product;
+
+			if (low < range) {
+				uint16_t threshold = (uint16_t)(65536 % range);
+
+				while (low < threshold) {
+					product = next_chunk() * (uint32_t)range;
+					low     = (uint16_t)product;
+				}
+			}
+
+			return product >> 16;
+		}
+
+	private:
+		inline uint32_t next_chunk() {
+			if (pool_size == 0) {
+				pool      = (*this)();
+				pool_size = 4;
+			}
+
+			uint32_t chunk = (uint32_t)(pool & 0xffff);
+
+			pool >>= 16;
+			pool_size--;
+
+			return chunk;
+		}
+	};
+
+	// Moves a uniformly chosen random subset of 'prefix_length' elements to the front of 'array', in random order.
+	// Only the first 'prefix_length' steps of a Fisher-Yates shuffle are performed.
+	template<typename T>
+	inline void partial_shuffle(T * array, int length, int prefix_length, Generator & rng) {
+		for (int i = 0; i < prefix_length; i++) {
+			int j = i + rng.bounded(length - i);
+
+			std::swap(array[i], array[j]);
+		}
+	}
+};
@@ -0,0 +1,302 @@
+#pragma once
+#include <cstring>
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "Peers.h"
+
+// MSVC allows intrinsics of any instruction set to be used in any function,
+// GCC and Clang require the function to be marked with the instruction sets it uses
+#ifdef _MSC_VER
+#define TARGET_AVX2
+#define TARGET_AVX512
+#else
+#define TARGET_AVX2   __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+// Lets Sudoku<N, M> and KnuthBatch use the AVX2 and AVX-512 kernels below, selected at startup with --kernels
+// They have not been faster than the scalar code on any size, see SIMDKernels<N, M>::instruction_set, so they are compiled out
+// by default, and Sudoku<N, M> calls the scalar code directly instead of checking the selected instruction set on every move.
+constexpr bool use_simd_kernels = false;
+
+namespace SIMD {
+	enum struct InstructionSet { SCALAR, AVX2, AVX512 };
+
+	inline const char * get_name(InstructionSet instruction_set) {
+		switch (instruction_set) {
+			case InstructionSet::AVX2:   return "AVX2";
+			case InstructionSet::AVX512: return "AVX-512";
+			default:                     return "Scalar";
+		}
+	}
+
+	// Finds the widest instruction set that is supported by both the processor and the operating system
+	inline InstructionSet detect_instruction_set() {
+#ifdef _MSC_VER
+		int info[4];
+
+		__cpuid(info, 0);
+		int max_leaf = info[0];
+
+		__cpuid(info, 1);
+		bool osxsave = info[2] & (1 << 27);
+		bool avx     = info[2] & (1 << 28);
+
+		if (!osxsave || !avx || max_leaf < 7) return InstructionSet::SCALAR;
+
+		// Check if the operating system saves the YMM and ZMM registers
+		unsigned long long xcr0 = _xgetbv(0);
+		if ((xcr0 & 0x06) != 0x06) return InstructionSet::SCALAR;
+
+		__cpuidex(info, 7, 0);
+		bool avx2    = info[1] & (1 << 5);
+		bool avx512f = info[1] & (1 << 16);
+
+		if (avx512f && (xcr0 & 0xe6) == 0xe6) return InstructionSet::AVX512;
+		if (avx2)                              return InstructionSet::AVX2;
+
+		return InstructionSet::SCALAR;
+#else
+		__builtin_cpu_init();
+
+		if (__builtin_cpu_supports("avx512f")) return InstructionSet::AVX512;
+		if (__builtin_cpu_supports("avx2"))    return InstructionSet::AVX2;
+
+		return InstructionSet::SCALAR;
+#endif
+	}
+
+	// Parses the name of an instruction set as given on the command line, "auto" selects the widest supported one
+	inline bool parse_instruction_set(const char * name, InstructionSet * instruction_set) {
+		if (strcmp(name, "auto")   == 0) { *instruction_set = detect_instruction_set(); return true; }
+		if (strcmp(name, "scalar") == 0) { *instruction_set = InstructionSet::SCALAR;   return true; }
+		if (strcmp(name, "avx2")   == 0) { *instruction_set = InstructionSet::AVX2;     return true; }
+		if (strcmp(name, "avx512") == 0) { *instruction_set = InstructionSet::AVX512;   return true; }
+
+		return false;
+	}
+};
+
+// The peers of every cell, distributed over vectors of 'Lanes' lanes.
+// Peer k (in ascending order) goes to lane k / group_count of group k % group_count.
+// Because there are at least 4 groups, two peers in the same group are at least 4 cells apart,
+// which means the 32 bit windows that are gathered and scattered around their bytes never overlap.
+template<int N, int M, int Lanes>
+struct PeerGroups {
+	static constexpr int size = N * M;
+
+	static constexpr int group_count = (Peers<N, M>::max_count + Lanes - 1) / Lanes < 4 ? 4 : (Peers<N, M>::max_count + Lanes - 1) / Lanes;
+
+	unsigned short indices   [size * size][group_count][Lanes];
+	unsigned char  lane_count[size * size][group_count];
+
+	constexpr PeerGroups() : indices(), lane_count() {
+		for (int cell_index = 0; cell_index < size * size; cell_index++) {
+			for (int k = 0; k < peers<N, M>.count[cell_index]; k++) {
+				int group = k % group_count;
+				int lane  = k / group_count;
+
+				indices   [cell_index][group][lane] = peers<N, M>.indices[cell_index][k];
+				lane_count[cell_index][group]++;
+			}
+		}
+	}
+};
+
+template<int N, int M, int Lanes>
+inline constexpr PeerGroups<N, M, Lanes> peer_groups;
+
+// Vectorized versions of the generated update functions for the counter layout of Sudoku<N, M>.
+// Every group of peers is updated with one gather and one scatter (or scalar stores for AVX2) of 32 bit windows,
+// the byte at the start of every window is the one that is being updated.
+// The resulting domain_sizes and constraints are exactly the same as the ones produced by the generated code.
+// NOTE: windows can extend up to 3 bytes past the end of the 'constraints' and 'domain_sizes' arrays,
+// these bytes are written back unmodified.
+template<int N, int M>
+struct SIMDKernels {
+	static constexpr int size = N * M;
+
+	TARGET_AVX512 static bool set_avx512(int cell_index, unsigned char domain_sizes[], unsigned char constraints[], int value) {
+		constexpr const PeerGroups<N, M, 16> & groups = peer_groups<N, M, 16>;
+
+		const __m512i vector_size  = _mm512_set1_epi32(size);
+		const __m512i vector_value = _mm512_set1_epi32(value);
+		const __m512i vector_byte  = _mm512_set1_epi32(0xff);
+		const __m512i vector_one   = _mm512_set1_epi32(1);
+
+		__mmask16 emptied = 0;
+
+		for (int g = 0; g < groups.group_count; g++) {
+			__mmask16 lanes = (__mmask16)((1u << groups.lane_count[cell_index][g]) - 1);
+
+			__m512i peer              = _mm512_maskz_cvtepu16_epi32(lanes, _mm256_loadu_si256((const __m256i *)groups.indices[cell_index][g]));
+			__m512i constraint_offset = _mm512_add_epi32(_mm512_mullo_epi32(peer, vector_size), vector_value);
+
+			__m512i constraint  = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), lanes, constraint_offset, constraints,  1);
+			__m512i domain_size = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), lanes, peer,              domain_sizes, 1);
+
+			// If the value was previously unconstrained for a peer, it is removed from that peer's domain
+			__mmask16 unconstrained = _mm512_mask_testn_epi32_mask(lanes, constraint, vector_byte);
+
+			constraint  = _mm512_add_epi32(constraint, vector_one);
+			domain_size = _mm512_mask_sub_epi32(domain_size, unconstrained, domain_size, vector_one);
+
+			_mm512_mask_i32scatter_epi32(constraints,  lanes, constraint_offset, constraint,  1);
+			_mm512_mask_i32scatter_epi32(domain_sizes, lanes, peer,              domain_size, 1);
+
+			emptied |= _mm512_mask_testn_epi32_mask(lanes, domain_size, vector_byte);
+		}
+
+		// Check whether all domains are still valid (i.e. non-empty)
+		return emptied == 0;
+	}
+
+	TARGET_AVX512 static void reset_avx512(int cell_index, unsigned char domain_sizes[], unsigned char constraints[], int value) {
+		constexpr const PeerGroups<N, M, 16> & groups = peer_groups<N, M, 16>;
+
+		const __m512i vector_size  = _mm512_set1_epi32(size);
+		const __m512i vector_value = _mm512_set1_epi32(value);
+		const __m512i vector_byte  = _mm512_set1_epi32(0xff);
+		const __m512i vector_one   = _mm512_set1_epi32(1);
+
+		for (int g = 0; g < groups.group_count; g++) {
+			__mmask16 lanes = (__mmask16)((1u << groups.lane_count[cell_index][g]) - 1);
+
+			__m512i peer              = _mm512_maskz_cvtepu16_epi32(lanes, _mm256_loadu_si256((const __m256i *)groups.indices[cell_index][g]));
+			__m512i constraint_offset = _mm512_add_epi32(_mm512_mullo_epi32(peer, vector_size), vector_value);
+
+			__m512i constraint  = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), lanes, constraint_offset, constraints,  1);
+			__m512i domain_size = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), lanes, peer,              domain_sizes, 1);
+
+			constraint = _mm512_sub_epi32(constraint, vector_one);
+
+			// If the value is no longer constrained for a peer, it is added back to that peer's domain
+			__mmask16 unconstrained = _mm512_mask_testn_epi32_mask(lanes, constraint, vector_byte);
+
+			domain_size = _mm512_mask_add_epi32(domain_size, unconstrained, domain_size, vector_one);
+
+			_mm512_mask_i32scatter_epi32(constraints,  lanes, constraint_offset, constraint,  1);
+			_mm512_mask_i32scatter_epi32(domain_sizes, lanes, peer,              domain_size, 1);
+		}
+	}
+
+	// AVX2 has gathers but no scatters, the updated bytes are written back one lane at a time
+	TARGET_AVX2 static bool set_avx2(int cell_index, unsigned char domain_sizes[], unsigned char constraints[], int value) {
+		constexpr const PeerGroups<N, M, 8> & groups = peer_groups<N, M, 8>;
+
+		const __m256i vector_size    = _mm256_set1_epi32(size);
+		const __m256i vector_value   = _mm256_set1_epi32(value);
+		const __m256i vector_byte    = _mm256_set1_epi32(0xff);
+		const __m256i vector_one     = _mm256_set1_epi32(1);
+		const __m256i vector_lane_id = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+		__m256i emptied = _mm256_setzero_si256();
+
+		alignas(32) int peer_array      [8];
+		alignas(32) int offset_array    [8];
+		alignas(32) int constraint_array[8];
+		alignas(32) int domain_array    [8];
+
+		for (int g = 0; g < groups.group_count; g++) {
+			int lane_count = groups.lane_count[cell_index][g];
+
+			__m256i lanes = _mm256_cmpgt_epi32(_mm256_set1_epi32(lane_count), vector_lane_id);
+
+			__m256i peer              = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)groups.indices[cell_index][g]));
+			__m256i constraint_offset = _mm256_add_epi32(_mm256_mullo_epi32(peer, vector_size), vector_value);
+
+			__m256i constraint  = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int *)constraints,  constraint_offset, lanes, 1);
+			__m256i domain_size = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int *)domain_sizes, peer,              lanes, 1);
+
+			// Lanes where the value was previously unconstrained are all ones, adding them decrements the domain size
+			__m256i unconstrained = _mm256_and_si256(lanes, _mm256_cmpeq_epi32(_mm256_and_si256(constraint, vector_byte), _mm256_setzero_si256()));
+
+			constraint  = _mm256_add_epi32(constraint,  vector_one);
+			domain_size = _mm256_add_epi32(domain_size, unconstrained);
+
+			emptied = _mm256_or_si256(emptied, _mm256_and_si256(lanes, _mm256_cmpeq_epi32(_mm256_and_si256(domain_size, vector_byte), _mm256_setzero_si256())));
+
+			_mm256_store_si256((__m256i *)peer_array,       peer);
+			_mm256_store_si256((__m256i *)offset_array,     constraint_offset);
+			_mm256_store_si256((__m256i *)constraint_array, constraint);
+			_mm256_store_si256((__m256i *)domain_array,     domain_size);
+
+			for (int lane = 0; lane < lane_count; lane++) {
+				constraints [offset_array[lane]] = (unsigned char)constraint_array[lane];
+				domain_sizes[peer_array  [lane]] = (unsigned char)domain_array    [lane];
+			}
+		}
+
+		// Check whether all domains are still valid (i.e. non-empty)
+		return _mm256_testz_si256(emptied, emptied);
+	}
+
+	TARGET_AVX2 static void reset_avx2(int cell_index, unsigned char domain_sizes[], unsigned char constraints[], int value) {
+		constexpr const PeerGroups<N, M, 8> & groups = peer_groups<N, M, 8>;
+
+		const __m256i vector_size    = _mm256_set1_epi32(size);
+		const __m256i vector_value   = _mm256_set1_epi32(value);
+		const __m256i vector_byte    = _mm256_set1_epi32(0xff);
+		const __m256i vector_one     = _mm256_set1_epi32(1);
+		const __m256i vector_lane_id = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+		alignas(32) int peer_array      [8];
+		alignas(32) int offset_array    [8];
+		alignas(32) int constraint_array[8];
+		alignas(32) int domain_array    [8];
+
+		for (int g = 0; g < groups.group_count; g++) {
+			int lane_count = groups.lane_count[cell_index][g];
+
+			__m256i lanes = _mm256_cmpgt_epi32(_mm256_set1_epi32(lane_count), vector_lane_id);
+
+			__m256i peer              = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)groups.indices[cell_index][g]));
+			__m256i constraint_offset = _mm256_add_epi32(_mm256_mullo_epi32(peer, vector_size), vector_value);
+
+			__m256i constraint  = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int *)constraints,  constraint_offset, lanes, 1);
+			__m256i domain_size = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int *)domain_sizes, peer,              lanes, 1);
+
+			constraint = _mm256_sub_epi32(constraint, vector_one);
+
+			// Lanes where the value is no longer constrained are all ones, subtracting them increments the domain size
+			__m256i unconstrained = _mm256_and_si256(lanes, _mm256_cmpeq_epi32(_mm256_and_si256(constraint, vector_byte), _mm256_setzero_si256()));
+
+			domain_size = _mm256_sub_epi32(domain_size, unconstrained);
+
+			_mm256_store_si256((__m256i *)peer_array,       peer);
+			_mm256_store_si256((__m256i *)offset_array,     constraint_offset);
+			_mm256_store_si256((__m256i *)constraint_array, constraint);
+			_mm256_store_si256((__m256i *)domain_array,     domain_size);
+
+			for (int lane = 0; lane < lane_count; lane++) {
+				constraints [offset_array[lane]] = (unsigned char)constraint_array[lane];
+				domain_sizes[peer_array  [lane]] = (unsigned char)domain_array    [lane];
+			}
+		}
+	}
+
+	// Instruction set used by Sudoku<N, M>, selected at startup using the --kernels command line option.
+	// Defaults to the generated scalar code, as gathers and scatters have turned out to be slower than
+	// the 30-40 scalar read-modify-writes on the processors we measured on.
+	inline static SIMD::InstructionSet instruction_set = SIMD::InstructionSet::SCALAR;
+
+	inline static bool set(int cell_index, unsigned char domain_sizes[], unsigned char constraints[], int value) {
+		if (instruction_set == SIMD::InstructionSet::AVX512) {
+			return set_avx512(cell_index, domain_sizes, constraints, value);
+		} else {
+			return set_avx2(cell_index, domain_sizes, constraints, value);
+		}
+	}
+
+	inline static void reset(int cell_index, unsigned char domain_sizes[], unsigned char constraints[], int value) {
+		if (instruction_set == SIMD::InstructionSet::AVX512) {
+			reset_avx512(cell_index, domain_sizes, constraints, value);
+		} else {
+			reset_avx2(cell_index, domain_sizes, constraints, value);
+		}
+	}
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <cmath>
+
+// Running mean and variance of a stream of samples, using Welford's algorithm.
+// Estimates of the larger sizes do not fit in a double once squared, so samples should be scaled down before they are added,
+// for example with ldexp(estimate.to_double(), -estimate_bit_count / 2). The relative variance does not depend on the scale.
+struct RunningStatistics {
+	unsigned long long count = 0;
+
+	double mean = 0.0;
+	double m2   = 0.0; // Sum of the squared differences from the mean
+
+	inline void add(double x) {
+		count++;
+
+		double delta = x - mean;
+
+		mean += delta / count;
+		m2   += delta * (x - mean);
+	}
+
+	// Combines the statistics of two disjoint sets of samples (Chan et al.)
+	inline void merge(const RunningStatistics & other) {
+		if (other.count == 0) return;
+
+		unsigned long long total_count = count + other.count;
+
+		double delta = other.mean - mean;
+
+		mean += delta * other.count / total_count;
+		m2   += other.m2 + delta * delta * ((double)count * other.count / total_count);
+
+		count = total_count;
+	}
+
+	// Sample variance, 0 for less than two samples
+	inline double get_variance() const {
+		return count > 1 ? m2 / (count - 1) : 0.0;
+	}
+
+	// Variance divided by the square of the mean, infinite if no sample was non-zero
+	inline double get_relative_variance() const {
+		return mean > 0.0 ? get_variance() / (mean * mean) : INFINITY;
+	}
+
+	// Standard error of the mean divided by the mean
+	inline double get_relative_standard_error() const {
+		return count > 0 ? sqrt(get_relative_variance() / count) : INFINITY;
+	}
+};
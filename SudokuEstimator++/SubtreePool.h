@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+// Work stealing queues of backtracking subtrees, shared by all estimator threads of a run.
+// A thread that runs into a large residual grid splits off subtrees and pushes them onto its own queue (see SudokuEstimator.cpp),
+// so that other threads can help counting them between their own samples.
+// The owner takes subtrees back from the end it pushes to, while other threads steal from the other end, where the
+// subtrees that were split off first and closest to the root are, which tend to be the largest.
+// A subtree is at least thousands of nodes, so a mutex per queue is cheap compared to the work it hands out.
+template<typename Task>
+struct SubtreePool {
+private:
+	struct alignas(64) Queue {
+		std::mutex        mutex;
+		std::deque<Task*> tasks;
+	};
+
+	Queue * queues;
+	int     queue_count;
+
+	// Total number of queued tasks, lets threads check for work without taking any locks
+	alignas(64) std::atomic<int> task_count = 0;
+
+public:
+	inline SubtreePool(int thread_count) : queue_count(thread_count) {
+		queues = new Queue[thread_count];
+	}
+
+	inline ~SubtreePool() {
+		delete[] queues;
+	}
+
+	SubtreePool(const SubtreePool &) = delete;
+	SubtreePool & operator=(const SubtreePool &) = delete;
+
+	inline bool has_tasks() const {
+		return task_count.load(std::memory_order_relaxed) > 0;
+	}
+
+	inline void push(int thread_index, Task * task) {
+		Queue & queue = queues[thread_index];
+
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.tasks.push_back(task);
+
+		task_count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// Returns the most recently pushed task of the own queue, otherwise steals the oldest task of another queue
+	// Returns nullptr if no task was found
+	inline Task * take(int thread_index) {
+		if (!has_tasks()) return nullptr;
+
+		for (int i = 0; i < queue_count; i++) {
+			Queue & queue = queues[(thread_index + i) % queue_count];
+
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			if (queue.tasks.empty()) continue;
+
+			Task * task;
+			if (i == 0) {
+				task = queue.tasks.back();
+				queue.tasks.pop_back();
+			} else {
+				task = queue.tasks.front();
+				queue.tasks.pop_front();
+			}
+
+			task_count.fetch_sub(1, std::memory_order_relaxed);
+
+			return task;
+		}
+
+		return nullptr;
+	}
+};
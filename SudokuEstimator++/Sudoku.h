@@ -1,7 +1,11 @@
 #pragma once
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 
-#include "Generated.h"
+#include "Peers.h"
+#include "Zobrist.h"
+#include "SIMDKernels.h"
 
 template<int N, int M = N> // N is the height of a block, M is the width of a block. The width and height of the entire Sudoku are N*M
 struct Sudoku {
@@ -16,10 +20,13 @@ struct Sudoku {
 	// If a number is not filled in, the value is 0
 	unsigned char grid[size * size];
 
+	uint64_t hash; // Zobrist hash of 'grid', kept up to date by set_with_forward_check and reset_cell if use_transposition_table is enabled
+
 	// 'constraints' stores a 1d array for each cell (x, y) in the Sudoku
 	// It contains at position [(x + y*size)*size + v - 1] the amount of variables in the row, column and block of position (x, y), that have value v.
 	// Thus if the value stored is 0, it means that v is in the domain of (x, y), as no other variable constrains that value.
 	// This setup allows for fast checking of domains
+	// NOTE: the SIMD kernels access 32 bit windows, so both arrays have to be followed by at least 3 bytes of the same object
 	unsigned char constraints [size * size * size];
 	unsigned char domain_sizes[size * size];
 
@@ -52,6 +59,8 @@ struct Sudoku {
 		}
 
 		empty_cells_length = size * size;
+
+		hash = 0;
 	}
 	
 	// Checks if the cell at (x, y) is allowed to assume the given value
@@ -59,6 +68,10 @@ struct Sudoku {
 		return constraints[cell_index * size + value] == 0;
 	}
 
+	inline int get_domain_size(int cell_index) const {
+		return domain_sizes[cell_index];
+	}
+
 	// Gets the domain of cell (x, y)
 	// Stores the resulting domain in result_domain, which should be an array of length >= size
 	// The size of the domain is returned
@@ -77,6 +90,28 @@ struct Sudoku {
 		return domain_size;
 	}
 	
+	// Gets the domain of cell (x, y) as a bitmask, bit v is set if value v is allowed
+	inline uint32_t get_domain_mask(int cell_index) const {
+		uint32_t mask = 0;
+
+		for (int value = 0; value < size; value++) {
+			mask |= (uint32_t)is_valid_move(cell_index, value) << value;
+		}
+
+		return mask;
+	}
+
+	// Removes a single value from the domain of cell (x, y), used by AC3
+	// If the domain becomes empty false is returned, true otherwise
+	inline bool remove_from_domain(int cell_index, int value) {
+		unsigned char & constraint = constraints[cell_index * size + value];
+
+		assert(constraint == 0);
+		constraint++;
+
+		return --domain_sizes[cell_index] != 0;
+	}
+	
 	// Prints the Sudoku to the console
 	inline void print() const {
 		for (int y = 0; y < size; y++) {
@@ -100,6 +135,37 @@ struct Sudoku {
 		}
 	}
 
+	// Updates the domains of all peers of the cell at (x, y) (see Peers.h), given that the cell now has the given value
+	// If any of those domains become empty false is returned, true otherwise
+	inline bool update_domains_set(int cell_index, int value) {
+		const unsigned short * cell_peers = peers<N, M>.indices[cell_index];
+		int                    peer_count = peers<N, M>.count  [cell_index];
+
+		bool valid = true;
+
+		for (int i = 0; i < peer_count; i++) {
+			int peer = cell_peers[i];
+
+			// If the value was previously unconstrained for the peer, it is removed from the peer's domain
+			valid &= (domain_sizes[peer] -= !(constraints[peer * size + value]++)) != 0;
+		}
+
+		return valid;
+	}
+
+	// Updates the domains of all peers of the cell at (x, y), given that the cell no longer has the given value
+	inline void update_domains_reset(int cell_index, int value) {
+		const unsigned short * cell_peers = peers<N, M>.indices[cell_index];
+		int                    peer_count = peers<N, M>.count  [cell_index];
+
+		for (int i = 0; i < peer_count; i++) {
+			int peer = cell_peers[i];
+
+			// If the value is no longer constrained for the peer, it is added back to the peer's domain
+			domain_sizes[peer] += !(--constraints[peer * size + value]);
+		}
+	}
+
 	// Sets the cell at (x, y) to the given value, using forward checking
 	// Updates all related domains (cells in the same row, column and block) that the cell has the new value
 	// If any of those domains become empty false is returned, true otherwise
@@ -109,8 +175,48 @@ struct Sudoku {
 
 		// Update all related domains that this grid is now a number
 
-		bool valid = Generated::table_set[cell_index](domain_sizes, constraints, value);
+		// The instruction set is only checked if the SIMD kernels are compiled in, see use_simd_kernels
+		bool valid;
+		if constexpr (use_simd_kernels) {
+			if (SIMDKernels<N, M>::instruction_set != SIMD::InstructionSet::SCALAR) {
+				valid = SIMDKernels<N, M>::set(cell_index, domain_sizes, constraints, value);
+			} else {
+				valid = update_domains_set(cell_index, value);
+			}
+		} else {
+			valid = update_domains_set(cell_index, value);
+		}
+		mark_filled(cell_index, value);
+
+		return valid;
+	}
+
+	// Resets the cell at (x, y) to zero
+	// Updates all related domains (cells in the same row, column and block) that the cell no longer has a value
+	inline void reset_cell(int cell_index) {
+		assert(grid[cell_index] != 0);
+		assert(empty_cells_length < size * size);
+
+		// Update all related domains that this grid is no longer a number
+		if constexpr (use_simd_kernels) {
+			if (SIMDKernels<N, M>::instruction_set != SIMD::InstructionSet::SCALAR) {
+				SIMDKernels<N, M>::reset(cell_index, domain_sizes, constraints, grid[cell_index] - 1);
+			} else {
+				update_domains_reset(cell_index, grid[cell_index] - 1);
+			}
+		} else {
+			update_domains_reset(cell_index, grid[cell_index] - 1);
+		}
+		mark_empty(cell_index);
+	}
+
+	// Stores the value of a cell that has just been set, and removes the cell from the empty cell list
+	// Does not update any domains, that is up to the caller
+	inline void mark_filled(int cell_index, int value) {
 		grid[cell_index] = value + 1;
+		if constexpr (use_transposition_table) {
+			hash ^= zobrist<N, M>.keys[cell_index][value];
+		}
 
 		// Remove the current cell from the empty cell list in O(1) time by swapping with the last element in that list
 		// - First look up the index of the current cell (x, y) in the empty cell list
@@ -123,18 +229,14 @@ struct Sudoku {
 		empty_cells      [empty_cell_index] = last_empty_cell;
 		empty_cells_index[last_empty_cell]  = empty_cell_index;
 		empty_cells_length--;
-
-		return valid;
 	}
 
-	// Resets the cell at (x, y) to zero
-	// Updates all related domains (cells in the same row, column and block) that the cell no longer has a value
-	inline void reset_cell(int cell_index) {
-		assert(grid[cell_index] != 0);
-		assert(empty_cells_length < size * size);
-
-		// Update all related domains that this grid is no longer a number
-		Generated::table_reset[cell_index](domain_sizes, constraints, grid[cell_index] - 1);
+	// Clears the value of a cell that has just been reset, and adds the cell back to the empty cell list
+	// Does not update any domains, that is up to the caller
+	inline void mark_empty(int cell_index) {
+		if constexpr (use_transposition_table) {
+			hash ^= zobrist<N, M>.keys[cell_index][grid[cell_index] - 1];
+		}
 		grid[cell_index] = 0;
 
 		// Store the cell after the last element in the empty cell list
@@ -142,4 +244,56 @@ struct Sudoku {
 		empty_cells_index[cell_index]= empty_cells_length;
 		empty_cells_length++;
 	}
+
+	// Checks that the SIMD kernels produce exactly the same state as the scalar code,
+	// by applying the same pseudo random sequence of moves to two Sudokus, using a different instruction set for each
+	inline static bool verify_kernels(SIMD::InstructionSet instruction_set, int move_count = 100000) {
+		SIMD::InstructionSet instruction_set_old = SIMDKernels<N, M>::instruction_set;
+
+		Sudoku * scalar     = new Sudoku();
+		Sudoku * vectorized = new Sudoku();
+
+		bool equal = true;
+		unsigned int state = 1;
+
+		for (int i = 0; i < move_count && equal; i++) {
+			state = state * 1103515245 + 12345; // Simple LCG, the quality of the random numbers does not matter here
+
+			int cell_index = (state >> 8) % (size * size);
+
+			if (scalar->grid[cell_index] == 0) {
+				// Only place values that are not used in the same row, column or block yet, like the estimator does
+				int domain[size];
+				int domain_size = scalar->get_domain(cell_index, domain);
+				if (domain_size == 0) continue;
+
+				int value = domain[(state >> 20) % domain_size];
+
+				SIMDKernels<N, M>::instruction_set = SIMD::InstructionSet::SCALAR;
+				bool valid_scalar = scalar->set_with_forward_check(cell_index, value);
+
+				SIMDKernels<N, M>::instruction_set = instruction_set;
+				bool valid_vectorized = vectorized->set_with_forward_check(cell_index, value);
+
+				equal = valid_scalar == valid_vectorized;
+			} else {
+				SIMDKernels<N, M>::instruction_set = SIMD::InstructionSet::SCALAR;
+				scalar->reset_cell(cell_index);
+
+				SIMDKernels<N, M>::instruction_set = instruction_set;
+				vectorized->reset_cell(cell_index);
+			}
+
+			equal = equal &&
+				memcmp(scalar->constraints,  vectorized->constraints,  sizeof(constraints))  == 0 &&
+				memcmp(scalar->domain_sizes, vectorized->domain_sizes, sizeof(domain_sizes)) == 0;
+		}
+
+		delete scalar;
+		delete vectorized;
+
+		SIMDKernels<N, M>::instruction_set = instruction_set_old;
+
+		return equal;
+	}
 };
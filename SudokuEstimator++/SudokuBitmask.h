@@ -0,0 +1,228 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+#include "Bits.h"
+#include "Zobrist.h"
+
+// Alternative state representation for Sudoku<N, M>, with the same interface.
+// Instead of a counter for every (cell, value) pair, every row, column and block stores a bitmask of the values used in it.
+// The domain of a cell is then a single AND-NOT of three masks, its size is a popcount and iterating it is a ctz loop.
+template<int N, int M = N> // N is the height of a block, M is the width of a block. The width and height of the entire Sudoku are N*M
+struct SudokuBitmask {
+	static constexpr int size = N * M;
+
+	using Mask = std::conditional_t<(size <= 16), uint16_t, uint32_t>;
+
+	static constexpr Mask full_mask = (Mask)((1u << size) - 1);
+
+	// Converts 2d grid cell coordinates (i, j) into a one dimensional index in a size * size grid
+	inline static constexpr int get_index(int i, int j) {
+		return i + j * size;
+	}
+
+	// Index of the block that contains the cell with the given index
+	inline static constexpr int get_block(int cell_index) {
+		return ((cell_index / size) / N) * N + (cell_index % size) / M;
+	}
+
+	// Sudoku grid, contains all currently filled in numbers
+	// If a number is not filled in, the value is 0
+	unsigned char grid[size * size];
+
+	uint64_t hash; // Zobrist hash of 'grid', kept up to date by set_with_forward_check and reset_cell if use_transposition_table is enabled
+
+	// Bit v of these masks is set if value v is used somewhere in the corresponding row, column or block
+	Mask row_used   [size];
+	Mask column_used[size];
+	Mask block_used [size];
+
+	// Values that were removed from the domain of a cell without being placed in one of its peers (i.e. by AC3)
+	Mask eliminated[size * size];
+
+	unsigned char empty_cells      [size * size]; // Keeps a list of indices that are currently empty
+	unsigned char empty_cells_index[size * size]; // Used to transform a cell index (i, j) into its index in the 'empty_cells' list
+	int empty_cells_length;				// Keeps track of the length of 'empty_cells'
+
+	inline SudokuBitmask() {
+		reset();
+	}
+
+	// Resets all cells to zero
+	// Domains are reset to be the numbers 1 .. N*M
+	inline void reset() {
+		for (int i = 0; i < size; i++) {
+			row_used   [i] = 0;
+			column_used[i] = 0;
+			block_used [i] = 0;
+		}
+
+		for (int index = 0; index < size * size; index++) {
+			grid[index] = 0;
+
+			eliminated[index] = 0;
+
+			empty_cells      [index] = index;
+			empty_cells_index[index] = index;
+		}
+
+		empty_cells_length = size * size;
+
+		hash = 0;
+	}
+
+	// Gets the domain of cell (x, y) as a bitmask, bit v is set if value v is allowed
+	inline Mask get_domain_mask(int cell_index) const {
+		int x = cell_index % size;
+		int y = cell_index / size;
+
+		return full_mask & ~(row_used[y] | column_used[x] | block_used[get_block(cell_index)] | eliminated[cell_index]);
+	}
+
+	// Checks if the cell at (x, y) is allowed to assume the given value
+	inline bool is_valid_move(int cell_index, int value) const {
+		return get_domain_mask(cell_index) & (1u << value);
+	}
+
+	inline int get_domain_size(int cell_index) const {
+		return Bits::popcount((uint32_t)get_domain_mask(cell_index));
+	}
+
+	// Gets the domain of cell (x, y)
+	// Stores the resulting domain in result_domain, which should be an array of length >= size
+	// The size of the domain is returned
+	inline int get_domain(int cell_index, int result_domain[size]) const {
+		uint32_t mask = get_domain_mask(cell_index);
+
+		int domain_size = 0;
+
+		while (mask) {
+			result_domain[domain_size++] = Bits::count_trailing_zeros(mask);
+
+			mask &= mask - 1;
+		}
+
+		return domain_size;
+	}
+
+	// Removes a single value from the domain of cell (x, y), used by AC3
+	// If the domain becomes empty false is returned, true otherwise
+	inline bool remove_from_domain(int cell_index, int value) {
+		assert(is_valid_move(cell_index, value));
+
+		eliminated[cell_index] |= (Mask)(1u << value);
+
+		return get_domain_mask(cell_index) != 0;
+	}
+
+	// Prints the Sudoku to the console
+	inline void print() const {
+		for (int y = 0; y < size; y++) {
+			for (int x = 0; x < size; x++) {
+				int value = grid[get_index(x, y)];
+
+				// When dealing with double-digit numbers, we might need to
+				// add one extra space to ensure proper alignment of numbers
+				if constexpr (size > 9) {
+					if (value > 9) {
+						printf("%u ", value);
+					} else {
+						printf("%u  ", value);
+					}
+				} else {
+					printf("%u ", value);
+				}
+			}
+
+			printf("\n");
+		}
+	}
+
+	// Sets the cell at (x, y) to the given value, using forward checking
+	// Marks the value as used in the row, column and block of the cell
+	// If the domain of any empty cell in the same row, column or block becomes empty false is returned, true otherwise
+	inline bool set_with_forward_check(int cell_index, int value) {
+		assert(grid[cell_index] == 0);
+		assert(value >= 0 && value < size);
+
+		int x = cell_index % size;
+		int y = cell_index / size;
+		int b = get_block(cell_index);
+
+		Mask bit = (Mask)(1u << value);
+
+		assert((row_used[y] & bit) == 0 && (column_used[x] & bit) == 0 && (block_used[b] & bit) == 0);
+
+		row_used   [y] |= bit;
+		column_used[x] |= bit;
+		block_used [b] |= bit;
+
+		grid[cell_index] = value + 1;
+		if constexpr (use_transposition_table) {
+			hash ^= zobrist<N, M>.keys[cell_index][value];
+		}
+
+		// Remove the current cell from the empty cell list in O(1) time by swapping with the last element in that list
+		int empty_cell_index = empty_cells_index[cell_index];
+		int last_empty_cell  = empty_cells[empty_cells_length - 1];
+		empty_cells      [empty_cell_index] = last_empty_cell;
+		empty_cells_index[last_empty_cell]  = empty_cell_index;
+		empty_cells_length--;
+
+		// Only peers that still had the value in their domain can have become empty
+		bool valid = true;
+
+		for (int i = 0; i < size; i++) {
+			valid &= domain_not_emptied(get_index(i, y));
+			valid &= domain_not_emptied(get_index(x, i));
+		}
+
+		int bx = M * (x / M);
+		int by = N * (y / N);
+
+		for (int j = by; j < by + N; j++) {
+			if (j == y) continue;
+
+			for (int i = bx; i < bx + M; i++) {
+				if (i == x) continue;
+
+				valid &= domain_not_emptied(get_index(i, j));
+			}
+		}
+
+		return valid;
+	}
+
+	// Resets the cell at (x, y) to zero
+	// Clears the value from the masks of the row, column and block of the cell
+	inline void reset_cell(int cell_index) {
+		assert(grid[cell_index] != 0);
+		assert(empty_cells_length < size * size);
+
+		int x = cell_index % size;
+		int y = cell_index / size;
+
+		Mask bit = (Mask)(1u << (grid[cell_index] - 1));
+
+		row_used   [y]                      &= ~bit;
+		column_used[x]                      &= ~bit;
+		block_used [get_block(cell_index)] &= ~bit;
+
+		if constexpr (use_transposition_table) {
+			hash ^= zobrist<N, M>.keys[cell_index][grid[cell_index] - 1];
+		}
+		grid[cell_index] = 0;
+
+		// Store the cell after the last element in the empty cell list
+		empty_cells[empty_cells_length] = cell_index;
+		empty_cells_index[cell_index] = empty_cells_length;
+		empty_cells_length++;
+	}
+
+private:
+	// A peer is only invalidated if it is still empty and its domain has become empty
+	inline bool domain_not_emptied(int cell_index) const {
+		return grid[cell_index] != 0 || get_domain_mask(cell_index) != 0;
+	}
+};
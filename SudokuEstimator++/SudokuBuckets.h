@@ -0,0 +1,141 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+
+#include "Bits.h"
+#include "Peers.h"
+#include "Sudoku.h"
+
+// Counter layout (see Sudoku.h) that additionally keeps the empty cells in buckets by domain size, for BucketTraverser.
+// Every bucket is a bitset over all cells, so the most constrained cell is the lowest set bit of the lowest non-empty bucket.
+// Placing or removing a value changes the domain size of a peer by at most one. The loop that updates the constraint counters
+// collects the peers whose domain changed in a bitset, and afterwards only the empty ones among them are moved one bucket.
+// This loop replaces the SIMD kernels, so this layout always runs scalar code.
+template<int N, int M = N>
+struct SudokuBuckets : Sudoku<N, M> {
+	using Base = Sudoku<N, M>;
+
+	static constexpr int size       = N * M;
+	static constexpr int word_count = (size * size + 63) / 64;
+
+	// Bit (index % 64) of word (index / 64) of bucket d is set if the cell with the given index is empty and has a domain of size d
+	uint64_t buckets[size + 1][word_count];
+
+	uint64_t empty_mask[word_count]; // Bit set for every empty cell
+
+	inline SudokuBuckets() {
+		reset();
+	}
+
+	inline void reset() {
+		Base::reset();
+
+		for (int w = 0; w < word_count; w++) {
+			for (int d = 0; d < size; d++) buckets[d][w] = 0;
+
+			buckets[size][w] = empty_mask[w] = get_word_mask(w);
+		}
+	}
+
+	inline bool remove_from_domain(int cell_index, int value) {
+		int domain_size = this->domain_sizes[cell_index];
+
+		toggle(domain_size,     cell_index);
+		toggle(domain_size - 1, cell_index);
+
+		return Base::remove_from_domain(cell_index, value);
+	}
+
+	inline bool set_with_forward_check(int cell_index, int value) {
+		assert(this->grid[cell_index] == 0);
+		assert(value >= 0 && value < size);
+
+		const unsigned short * cell_peers = peers<N, M>.indices[cell_index];
+		int                    peer_count = peers<N, M>.count  [cell_index];
+
+		bool valid = true;
+
+		uint64_t removed_mask[word_count] = { };
+
+		for (int i = 0; i < peer_count; i++) {
+			int peer = cell_peers[i];
+
+			// If the value was previously unconstrained for the peer, it is removed from the peer's domain
+			int removed = !(this->constraints[peer * size + value]++);
+
+			valid &= (this->domain_sizes[peer] -= removed) != 0;
+
+			removed_mask[peer >> 6] |= (uint64_t)removed << (peer & 63);
+		}
+
+		// Every peer whose domain shrunk moves down one bucket
+		move_buckets(removed_mask, 1);
+
+		this->mark_filled(cell_index, value);
+		toggle_empty(cell_index);
+		toggle(this->domain_sizes[cell_index], cell_index);
+
+		return valid;
+	}
+
+	inline void reset_cell(int cell_index) {
+		assert(this->grid[cell_index] != 0);
+		assert(this->empty_cells_length < size * size);
+
+		int value = this->grid[cell_index] - 1;
+
+		const unsigned short * cell_peers = peers<N, M>.indices[cell_index];
+		int                    peer_count = peers<N, M>.count  [cell_index];
+
+		uint64_t added_mask[word_count] = { };
+
+		for (int i = 0; i < peer_count; i++) {
+			int peer = cell_peers[i];
+
+			// If the value is no longer constrained for the peer, it is added back to the peer's domain
+			int added = !(--this->constraints[peer * size + value]);
+
+			this->domain_sizes[peer] += added;
+
+			added_mask[peer >> 6] |= (uint64_t)added << (peer & 63);
+		}
+
+		// Every peer whose domain grew moves up one bucket
+		move_buckets(added_mask, -1);
+
+		this->mark_empty(cell_index);
+		toggle_empty(cell_index);
+		toggle(this->domain_sizes[cell_index], cell_index);
+	}
+
+private:
+	// Bits of the given word that correspond to actual cells
+	inline static constexpr uint64_t get_word_mask(int w) {
+		return (w + 1) * 64 <= size * size ? ~0ull : (1ull << (size * size - w * 64)) - 1;
+	}
+
+	// Moves every cell in 'cell_mask' from the bucket of its previous domain size, which is 'offset' above its current one
+	inline void move_buckets(const uint64_t cell_mask[word_count], int offset) {
+		for (int w = 0; w < word_count; w++) {
+			uint64_t mask = cell_mask[w] & empty_mask[w];
+
+			while (mask) {
+				int cell_index  = w * 64 + Bits::count_trailing_zeros(mask);
+				int domain_size = this->domain_sizes[cell_index];
+
+				toggle(domain_size + offset, cell_index);
+				toggle(domain_size,          cell_index);
+
+				mask &= mask - 1;
+			}
+		}
+	}
+
+	inline void toggle(int domain_size, int cell_index) {
+		buckets[domain_size][cell_index >> 6] ^= 1ull << (cell_index & 63);
+	}
+
+	inline void toggle_empty(int cell_index) {
+		empty_mask[cell_index >> 6] ^= 1ull << (cell_index & 63);
+	}
+};
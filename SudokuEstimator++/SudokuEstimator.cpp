@@ -1,33 +1,40 @@
 #include "SudokuEstimator.h"
 
-#include <mutex>
 #include <chrono>
+#include <thread>
+#include <algorithm>
 
 #include "AC3.h"
+#include "Bits.h"
 #include "Constants.h"
+#include "EstimateLog.h"
+#include "Statistics.h"
+#include "Symmetry.h"
 
-struct Results {
-	std::mutex mutex;
+template<int N, int M>
+void SudokuEstimator<N, M>::backtrack_with_forward_check() {
+	assert(sudoku.grid[traverser.index] == 0);
 
-	BigInteger   sum = 0;
-	unsigned int n   = 0;
+	uint64_t backtrack_before  = backtrack;
+	uint64_t node_count_before = node_count++;
 
-	unsigned long long time = 0;
-} results;
+	// Reuse the solution count if the same residual grid was already counted
+	if constexpr (use_transposition_table) {
+		uint64_t solution_count;
+		if (transposition_table.lookup(sudoku.hash, solution_count)) {
+			backtrack += solution_count;
 
-void SudokuEstimator::backtrack_with_forward_check() {
-	int current_index = traverser.index;;
-	
-	assert(sudoku.grid[current_index] == 0);
-
-	int domain[Sudoku<N, M>::size];
-	int domain_size = sudoku.get_domain(current_index, domain);
+			return;
+		}
+	}
 
-	assert(domain_size == sudoku.domain_sizes[current_index]);
+	int      current_index;
+	uint32_t values = select_branch(current_index);
 
 	// Try all possible values for the cell at (x, y)
-	for (int i = 0 ; i < domain_size; i++) {
-		int value = domain[i];
+	while (values) {
+		int value = Bits::count_trailing_zeros(values);
+		values &= values - 1;
 		
 		// Try the current value
 		if (sudoku.set_with_forward_check(current_index, value)) {
@@ -46,11 +53,220 @@ void SudokuEstimator::backtrack_with_forward_check() {
 
 		sudoku.reset_cell(current_index);
 	}
+
+	if constexpr (use_transposition_table) {
+		transposition_table.store(sudoku.hash, backtrack - backtrack_before, node_count - node_count_before);
+	}
 }
 
-void SudokuEstimator::knuth() {
-	estimate = 1;
+template<int N, int M>
+void SudokuEstimator<N, M>::enter_frame(int & depth) {
+	uint64_t node_count_before = node_count++;
+
+	// Reuse the solution count if the same residual grid was already counted
+	if constexpr (use_transposition_table) {
+		uint64_t solution_count;
+		if (transposition_table.lookup(sudoku.hash, solution_count)) {
+			backtrack += solution_count;
+
+			return;
+		}
+	}
+
+	BacktrackFrame & frame = backtrack_stack[++depth];
+	frame.remaining_values  = select_branch(frame.cell_index);
+	frame.complete          = true;
+	frame.backtrack_before  = backtrack;
+	frame.node_count_before = node_count_before;
+}
+
+template<int N, int M>
+void SudokuEstimator<N, M>::run_frames(int depth) {
+	while (depth >= 0) {
+		BacktrackFrame & frame = backtrack_stack[depth];
+
+		// Undo the value that was tried last, if any
+		if (sudoku.grid[frame.cell_index] != 0) sudoku.reset_cell(frame.cell_index);
+
+		// Hand out part of a large tree to the other threads
+		if (split_group != nullptr && node_count >= split_node_count) split_frames(depth);
+
+		// All values were tried, leave the node
+		if (frame.remaining_values == 0) {
+			if constexpr (use_transposition_table) {
+				if (frame.complete) {
+					transposition_table.store(sudoku.hash, backtrack - frame.backtrack_before, node_count - frame.node_count_before);
+				}
+			}
+
+			depth--;
+
+			continue;
+		}
+
+		int value = Bits::count_trailing_zeros(frame.remaining_values);
+		frame.remaining_values &= frame.remaining_values - 1;
+
+		// Try the next value, the same way as backtrack_with_forward_check()
+		if (sudoku.set_with_forward_check(frame.cell_index, value)) {
+			if (traverser.move(&sudoku)) {
+				backtrack += 1;
+			} else {
+				enter_frame(depth);
+			}
+		}
+	}
+}
+
+template<int N, int M>
+void SudokuEstimator<N, M>::backtrack_iterative() {
+	int root_index = traverser.index;
+
+	int depth = -1;
+
+	enter_frame(depth);
+	run_frames(depth);
+
+	traverser.index = root_index;
+}
+
+template<int N, int M>
+void SudokuEstimator<N, M>::split_frames(int depth) {
+	// Rebuild the grid of the root of the tree, the frames form the trail of cells that were set since then
+	// The cell of the top frame was just reset, every frame below it has a value set
+	split_state = sudoku;
+
+	for (int i = depth - 1; i >= 0; i--) {
+		split_state.reset_cell(backtrack_stack[i].cell_index);
+	}
+
+	// Hand out the untried values of the frames closest to the root, walking the trail back down
+	int split_count = 0;
+	int last_split  = -1;
+
+	for (int i = 0; i <= depth && split_count < PARALLEL_BACKTRACK_SPLIT_FRAME_COUNT; i++) {
+		BacktrackFrame & frame = backtrack_stack[i];
+
+		if (frame.remaining_values != 0) {
+			SubtreeTask * task = new SubtreeTask { split_state, frame.cell_index, frame.remaining_values, split_group };
+
+			split_group->pending_count.fetch_add(1, std::memory_order_relaxed);
+			subtrees->push(thread_index, task);
+
+			frame.remaining_values = 0;
+
+			split_count++;
+			last_split = i;
+		}
+
+		if (i < depth) {
+			bool valid = split_state.set_with_forward_check(frame.cell_index, sudoku.grid[frame.cell_index] - 1);
+
+			assert(valid);
+		}
+	}
+
+	// The counts of the frames that were split and of the frames above them no longer cover their entire grid
+	for (int i = 0; i <= last_split; i++) {
+		backtrack_stack[i].complete = false;
+	}
+
+	split_node_count = node_count + PARALLEL_BACKTRACK_SPLIT_NODE_COUNT;
+}
+
+template<int N, int M>
+void SudokuEstimator<N, M>::count_subtree(SubtreeTask * task) {
+	// Neither a sample that is waiting for its own subtrees nor a thread that is in between samples needs the grid,
+	// the stack or the traverser, so the subtree is counted in place
+	uint64_t       backtrack_before        = backtrack;
+	SubtreeGroup * split_group_before      = split_group;
+	uint64_t       split_node_count_before = split_node_count;
+
+	sudoku = task->sudoku;
+
+	backtrack        = 0;
+	split_group      = task->group;
+	split_node_count = node_count + PARALLEL_BACKTRACK_SPLIT_NODE_COUNT;
+
+	// The subtree consists of some of the values of a frame, whose count is not the count of its grid
+	BacktrackFrame & frame = backtrack_stack[0];
+	frame.cell_index        = task->cell_index;
+	frame.remaining_values  = task->values;
+	frame.complete          = false;
+	frame.backtrack_before  = 0;
+	frame.node_count_before = node_count;
 
+	run_frames(0);
+
+	SubtreeGroup * group = task->group;
+	delete task;
+
+	// The owner of the group may return as soon as the pending count reaches zero, so the group is not touched after that
+	group->solution_count.fetch_add(backtrack, std::memory_order_relaxed);
+	group->pending_count .fetch_sub(1,         std::memory_order_release);
+
+	backtrack        = backtrack_before;
+	split_group      = split_group_before;
+	split_node_count = split_node_count_before;
+}
+
+template<int N, int M>
+void SudokuEstimator<N, M>::backtrack_parallel() {
+	SubtreeGroup group;
+
+	split_group      = &group;
+	split_node_count = node_count + PARALLEL_BACKTRACK_SPLIT_NODE_COUNT;
+
+	backtrack_iterative();
+
+	split_group = nullptr;
+
+	// Help counting until all subtrees that were split off are counted, the own ones are taken first
+	while (group.pending_count.load(std::memory_order_acquire) != 0) {
+		SubtreeTask * task = subtrees->take(thread_index);
+
+		if (task != nullptr) {
+			count_subtree(task);
+		} else {
+			std::this_thread::yield();
+		}
+	}
+
+	backtrack += group.solution_count.load(std::memory_order_relaxed);
+}
+
+template<int N, int M>
+void SudokuEstimator<N, M>::backtrack_canonical() {
+	// Equivalent grids have the same number of solutions
+	uint64_t key = Symmetry::get_canonical_hash<N, M>(sudoku);
+
+	uint64_t solution_count;
+	if (transposition_table.lookup(key, solution_count)) {
+		backtrack += solution_count;
+
+		return;
+	}
+
+	uint64_t backtrack_before  = backtrack;
+	uint64_t node_count_before = node_count;
+
+	backtrack_solutions();
+
+	transposition_table.store(key, backtrack - backtrack_before, node_count - node_count_before);
+}
+
+template<int N, int M>
+void SudokuEstimator<N, M>::knuth() {
+	switch (proposal) {
+		case Knuth::Proposal::VIABLE:       knuth_weighted<Knuth::Proposal::VIABLE>();       break;
+		case Knuth::Proposal::PEER_DOMAINS: knuth_weighted<Knuth::Proposal::PEER_DOMAINS>(); break;
+
+		default: knuth_uniform(); break;
+	}
+}
+
+template<int N, int M>
+void SudokuEstimator<N, M>::knuth_uniform() {
 	int domain[Sudoku<N, M>::size];
 
 	for (int i = 0; i < random_walk_length; i++) {
@@ -65,11 +281,10 @@ void SudokuEstimator::knuth() {
 			return;
 		}
 
-		estimate *= domain_size;
+		if (!multiply_estimate(estimate, domain_size)) return;
 
 		// Pick a random value from the domain
-		std::uniform_int_distribution<int> distribution(0, domain_size - 1);
-		int random_value_from_domain = domain[distribution(rng)];
+		int random_value_from_domain = domain[rng.bounded(domain_size)];
 
 		// Use forward checking for a possible early out
 		// If any domain becomes empty the Sudoku can't be completed and 0 can be returned.
@@ -81,39 +296,72 @@ void SudokuEstimator::knuth() {
 	}
 }
 
-void SudokuEstimator::estimate_solution_count() {
-	// Reset all cells to 0 and clear domains
-	sudoku.reset();
+template<int N, int M>
+template<Knuth::Proposal PROPOSAL>
+void SudokuEstimator<N, M>::knuth_weighted() {
+	int      domain [Sudoku<N, M>::size];
+	uint32_t weights[Sudoku<N, M>::size];
 
-	// Fill every Nth row with a row from a random M x N*M Latin Rectangle
-	// The first row is always 1 .. N*M
-	int rows[M][Sudoku<N, M>::size];
+	for (int i = 0; i < random_walk_length; i++) {
+		int cell_index = coordinates[i];
 
-	// Initialize each row of the Latin Rectangle with the numbers 1 .. N*M
-	for (int row = 0; row < M; row++) {
-		for (int i = 0; i < Sudoku<N, M>::size; i++) {
-			rows[row][i] = i;
+		assert(sudoku.grid[cell_index] == 0); // Cell should be empty
+
+		int      domain_size  = sudoku.get_domain(cell_index, domain);
+		uint32_t total_weight = Knuth::get_weights<N, M, PROPOSAL>(sudoku, cell_index, domain, domain_size, weights);
+
+		// None of the values can lead to a solution
+		if (total_weight == 0) {
+			estimate = 0;
+
+			return;
+		}
+
+		// Pick a value with a probability proportional to its weight
+		uint32_t r = rng.bounded(total_weight);
+
+		int index = 0;
+		while (r >= weights[index]) {
+			r -= weights[index];
+			index++;
+		}
+
+		// Multiply by total_weight / weight, rounded up or down at random such that the expected factor is exact
+		uint32_t weight = weights[index];
+		uint32_t factor = total_weight / weight + ((uint32_t)rng.bounded(weight) < total_weight % weight);
+
+		if (!multiply_estimate(estimate, factor)) return;
+
+		// The weights only rule out values that empty an empty peer, forward checking also covers the filled peers
+		if (!sudoku.set_with_forward_check(cell_index, domain[index])) {
+			estimate = 0;
+
+			return;
 		}
 	}
+}
 
-	// Repeat until a valid Latin Rectangle is obtained
-	retry: {
-		// Randomly shuffle every row but the first one
-		for (int row = 1; row < M; row++) {
-			std::shuffle(rows[row], rows[row] + Sudoku<N, M>::size, rng);
+template<int N, int M>
+bool SudokuEstimator<N, M>::sample_latin_rectangle(int rows[M][Sudoku<N, M>::size]) {
+	// The first row is always 1 .. N*M
+	estimate = 1;
 
-			// Check if the current permutation of rows is still a Latin Rectangle
-			for (int i = 0; i < Sudoku<N, M>::size; i++) {
-				for (int j = 0; j < row; j++) {
-					if (rows[row][i] == rows[j][i]) {
-						// Not a valid Latin Rectangle, retry
-						goto retry;
-					}
-				}
-			}
+	if constexpr (latin_rectangle_sampler == LatinRectangle::Sampler::REJECTION) {
+		LatinRectangle::sample_rejection<N, M>(rows, rng);
+	} else {
+		// The estimate starts out with the importance weight of the Latin Rectangle
+		if (!LatinRectangle::sample_sequential<N, M>(rows, estimate, rng)) {
+			estimate = 0;
+
+			return false;
 		}
 	}
 
+	return true;
+}
+
+template<int N, int M>
+void SudokuEstimator<N, M>::fill_rows(const int rows[M][Sudoku<N, M>::size]) {
 	// Fill every Nth row of the Sudoku with a row from the Latin Rectangle
 	for (int row = 0; row < M; row++) {
 		for (int i = 0; i < Sudoku<N, M>::size; i++) {
@@ -122,18 +370,43 @@ void SudokuEstimator::estimate_solution_count() {
 			assert(domains_valid);
 		}
 	}
-	
-	// Select s random cells from the other rows.
-	std::shuffle(coordinates, coordinates + coordinate_count, rng);
+}
+
+template<int N, int M>
+bool SudokuEstimator<N, M>::fill_latin_rectangle() {
+	// Fill every Nth row with a row from a random M x N*M Latin Rectangle
+	int rows[M][Sudoku<N, M>::size];
+
+	if (!sample_latin_rectangle(rows)) return false;
+
+	fill_rows(rows);
+
+	return true;
+}
+
+template<int N, int M>
+void SudokuEstimator<N, M>::estimate_solution_count() {
+	// Reset all cells to 0 and clear domains
+	sudoku.reset();
+
+	if (!fill_latin_rectangle()) return;
+
+	// Select s random cells from the other rows, only the first s coordinates are shuffled since Knuth's algorithm uses no more
+	Random::partial_shuffle(coordinates, coordinate_count, random_walk_length, rng);
 
 	// Estimate using Knuth's algorithm
 	knuth();
 
-	if (BigIntegerMath::is_zero(estimate)) return;
+	if (estimate.is_zero()) return;
+
+	count_residual_solutions();
+}
 
+template<int N, int M>
+void SudokuEstimator<N, M>::count_residual_solutions() {
 	// Reduce domain sizes using AC3
 	// If a domain was made empty, return false
-	if (!ac3(&sudoku)) {
+	if (!enforce_arc_consistency()) {
 		estimate = 0;
 
 		return;
@@ -143,20 +416,131 @@ void SudokuEstimator::estimate_solution_count() {
 
 	// Count all Sudoku solutions that contain the current configuration as a subset
 	backtrack = 0;
-	backtrack_with_forward_check();
+
+	if constexpr (use_symmetry_cache) {
+		backtrack_canonical();
+	} else {
+		backtrack_solutions();
+	}
 	
-	if (BigIntegerMath::is_zero(backtrack)) {
+	if (backtrack == 0) {
 		estimate = 0;
 
 		return;
 	}
 
 	// Multiply our estimate, the exact amount of backtracking solutions and a constant
-	estimate *= backtrack;
+	multiply_estimate(estimate, backtrack);
+}
+
+template<int N, int M>
+void SudokuEstimator<N, M>::estimate_solution_counts(Estimate * estimates, int sample_count) {
+	assert(sample_count <= KNUTH_BATCH_LANES);
+
+	uint32_t alive = 0; // Lanes whose random walk has not run into an empty domain yet
+
+	for (int lane = 0; lane < sample_count; lane++) {
+		KnuthLane & knuth_lane = knuth_lanes[lane];
+
+		bool valid = sample_latin_rectangle(knuth_lane.rows);
+
+		estimates[lane] = estimate;
+
+		if (!valid) continue;
+
+		// Every lane shuffles the coordinates that the previous lane left behind, like consecutive calls to estimate_solution_count()
+		Random::partial_shuffle(coordinates, coordinate_count, random_walk_length, rng);
+
+		for (int i = 0; i < random_walk_length; i++) knuth_lane.cells[i] = coordinates[i];
+
+		knuth_lane.factor = 1;
+
+		knuth_batch.reset_lane(lane, knuth_lane.rows);
+
+		alive |= 1u << lane;
+	}
+
+	int cells [KNUTH_BATCH_LANES];
+	int values[KNUTH_BATCH_LANES];
+
+	// Same steps as knuth_uniform(), for all lanes that are still alive
+	for (int i = 0; i < random_walk_length && alive != 0; i++) {
+		for (uint32_t lanes = alive; lanes != 0; lanes &= lanes - 1) {
+			int lane = Bits::count_trailing_zeros(lanes);
+
+			KnuthLane & knuth_lane = knuth_lanes[lane];
+
+			int      cell_index = knuth_lane.cells[i];
+			uint32_t domain     = knuth_batch.domains[cell_index][lane];
+
+			if (domain == 0) {
+				estimates[lane] = 0;
+				alive &= ~(1u << lane);
+
+				continue;
+			}
+
+			int domain_size = Bits::popcount(domain);
+
+			// The factors are collected in a single word, and only multiplied into the estimate before they could overflow it
+			if (knuth_lane.factor > UINT64_MAX / Sudoku<N, M>::size) {
+				if (!multiply_estimate(estimates[lane], knuth_lane.factor)) {
+					alive &= ~(1u << lane);
+
+					continue;
+				}
+				knuth_lane.factor = 1;
+			}
+			knuth_lane.factor *= domain_size;
+
+			// Pick a random value from the domain
+			for (int r = rng.bounded(domain_size); r > 0; r--) domain &= domain - 1;
+
+			int value = Bits::count_trailing_zeros(domain);
+
+			knuth_lane.values[i] = value;
+
+			cells [lane] = cell_index;
+			values[lane] = value;
+		}
+
+		// Forward checking for all lanes at once
+		uint32_t emptied = knuth_batch.set(cells, values, alive);
+
+		for (uint32_t lanes = emptied; lanes != 0; lanes &= lanes - 1) {
+			estimates[Bits::count_trailing_zeros(lanes)] = 0;
+		}
+
+		alive &= ~emptied;
+	}
+
+	// Lanes that survived the random walk are replayed into the grid, and counted one at a time like in estimate_solution_count()
+	for (uint32_t lanes = alive; lanes != 0; lanes &= lanes - 1) {
+		int lane = Bits::count_trailing_zeros(lanes);
+
+		KnuthLane & knuth_lane = knuth_lanes[lane];
+
+		sudoku.reset();
+
+		fill_rows(knuth_lane.rows);
+
+		for (int i = 0; i < random_walk_length; i++) {
+			bool domains_valid = sudoku.set_with_forward_check(knuth_lane.cells[i], knuth_lane.values[i]);
+
+			assert(domains_valid);
+		}
+
+		estimate = estimates[lane];
+
+		if (multiply_estimate(estimate, knuth_lane.factor)) count_residual_solutions();
+
+		estimates[lane] = estimate;
+	}
 }
 
-void SudokuEstimator::run(int thread_index) {
-	rng = std::mt19937(random_device());
+template<int N, int M>
+SudokuEstimator<N, M>::SudokuEstimator(int random_walk_length) : random_walk_length(random_walk_length), transposition_table(use_transposition_table || use_symmetry_cache ? TRANSPOSITION_TABLE_BUCKET_COUNT : 1) {
+	assert(random_walk_length >= 0 && random_walk_length <= coordinate_count); // Length of the random walk cannot be longer than the available number of cells
 
 	int index = 0;
 	for (int j = 1; j < Sudoku<N, M>::size; j++) {
@@ -166,84 +550,232 @@ void SudokuEstimator::run(int thread_index) {
 			coordinates[index++] = Sudoku<N, M>::get_index(i, j);
 		}
 	}
+}
+
+template<int N, int M>
+void SudokuEstimator<N, M>::run(Results * results, Subtrees * subtrees, uint64_t seed, int thread_index) {
+	if constexpr (use_parallel_backtracking) {
+		this->subtrees = subtrees;
+	}
+	this->thread_index = thread_index;
 
-	char results_file_name[64];
-	sprintf_s(results_file_name, "Results/results_%ux%u_s=%u.txt", N, M, random_walk_length);
+	// Every thread writes to its own results file, named after the seed and the thread
+	char results_file_name[128];
+	snprintf(results_file_name, sizeof(results_file_name), "Results/results_%ux%u_s=%u%s_%016llx_%u.bin", N, M, random_walk_length, LatinRectangle::get_file_suffix(latin_rectangle_sampler), (unsigned long long)seed, thread_index);
+
+	EstimateLog::Header header = EstimateLog::make_header(N, M, random_walk_length, (uint32_t)latin_rectangle_sampler, Estimate::limb_count, seed, thread_index);
+	EstimateLog::Writer<Estimate::limb_count> log(results_file_name, header);
+
+	Estimate batch[BATCH_SIZE];
+
+	// Running totals of this thread
+	typename Results::Sum total_sum  = 0;
+	unsigned long long    total_n    = 0;
+	unsigned long long    total_time = 0;
+
+	RunningStatistics statistics;
+	RunningStatistics batch_statistics; // Of the means of every CONFIDENCE_BATCH_SIZE scaled estimates
+
+	double batch_sum = 0.0; // Sum of the scaled estimates since the last batch mean
+
+	static_assert(CONFIDENCE_BATCH_SIZE % BATCH_SIZE == 0, "Batch means should cover whole batches");
+
+	for (uint64_t batch_index = 0; !results->is_stop_requested(); batch_index++) {
+		// Every batch uses its own stream, so any batch can be reproduced without replaying the ones before it
+		rng = Random::Generator(Random::derive_key(seed, thread_index, batch_index));
 
-	BigInteger batch_sum;
-	BigInteger batch[BATCH_SIZE];
-	
-	while (true) {	
 		auto start_time = std::chrono::high_resolution_clock::now();
 		
-		batch_sum = 0;
+		// Compute 'batch_size' estimations
+		for (int i = 0; i < BATCH_SIZE; i += use_batched_knuth ? KNUTH_BATCH_LANES : 1) {
+			// Help other threads with their large residual grids first
+			if (this->subtrees != nullptr) {
+				while (SubtreeTask * task = this->subtrees->take(thread_index)) {
+					count_subtree(task);
+				}
+			}
 
-		// Sum 'batch_size' estimations
-		for (int i = 0; i < BATCH_SIZE; i++) {
-			estimate_solution_count();
+			if constexpr (use_batched_knuth) {
+				estimate_solution_counts(batch + i, std::min(KNUTH_BATCH_LANES, BATCH_SIZE - i));
+			} else {
+				estimate_solution_count();
 
-			batch_sum += estimate;
-			batch[i]   = estimate;
+				batch[i] = estimate;
+			}
 		}
 
 		auto      stop_time = std::chrono::high_resolution_clock::now();
 		long long duration  = std::chrono::duration_cast<std::chrono::microseconds>(stop_time - start_time).count();
 
-		// Store the result in a thread safe way
-		results.mutex.lock();
-		{
-			results.sum  += batch_sum;
-			results.n    += BATCH_SIZE;
-			results.time += duration;
+		for (int i = 0; i < BATCH_SIZE; i++) {
+			total_sum += batch[i];
 
-			FILE * file;
-			if (fopen_s(&file, results_file_name, "a") != 0) {
-				abort();
-			}
+			double scaled_estimate = get_scaled_estimate(batch[i]);
 
-			for (int i = 0; i < BATCH_SIZE; i++) {
-				mpz_ptr estimate = batch[i].__get_mp();
-				mpz_out_str(file, 10, estimate);
-				fprintf(file, "\n");
-			}
+			statistics.add(scaled_estimate);
+			batch_sum += scaled_estimate;
+		}
+		total_n    += BATCH_SIZE;
+		total_time += duration;
+
+		if (total_n % CONFIDENCE_BATCH_SIZE == 0) {
+			batch_statistics.add(batch_sum / CONFIDENCE_BATCH_SIZE);
+
+			batch_sum = 0.0;
+		}
+
+		// Publish the new totals, this never waits on other threads
+		results->publish(total_sum, total_n, total_time, overflow_count, statistics, batch_statistics);
 
-			fclose(file);
+		for (int i = 0; i < BATCH_SIZE; i++) {
+			log.append(batch[i]);
 		}
-		results.mutex.unlock();
+		log.flush_if_due();
 	}
+
+	results->finish();
 }
 
-void report_results() {
+template<int N, int M>
+void report_results(int random_walk_length, typename SudokuEstimator<N, M>::Results * results, int thread_count, double target_precision) {
 	// True number of N*M x N*M Sudoku grids 
 	BigInteger true_value            = Constants::get_true_value<N, M>();
 	BigInteger latin_rectangle_count = Constants::get_latin_rectangle_count<N, M>();
 
+	// Estimates from the rejection sampler are averaged over all Latin Rectangles, so they are scaled by the number of Latin Rectangles.
+	// Estimates from the sequential sampler already sum over all Latin Rectangles with the same first row,
+	// so they only need to be scaled by the number of possible first rows.
+	BigInteger scale = latin_rectangle_sampler == LatinRectangle::Sampler::REJECTION ? latin_rectangle_count : BigIntegerMath::factorial(N * M);
+
 	std::string true_value_str = true_value.get_str();
 
+	printf("Estimating the number of %ux%u Sudoku grids, using random walks of length %u and the %s Latin Rectangle sampler\n", N, M, random_walk_length, LatinRectangle::get_name(latin_rectangle_sampler));
+
+	if (target_precision > 0.0) {
+		printf("Stopping once the approximate 95%% confidence interval is within +-%.3f%% of the average at %u checks in a row, after at least %u samples\n", 100.0 * target_precision, STOPPING_CHECK_COUNT, MIN_STOPPING_SAMPLE_COUNT);
+	}
+
+	printf("\n");
+
+	typename SudokuEstimator<N, M>::Results::Sum thread_sum;
+	unsigned long long                           thread_n;
+	unsigned long long                           thread_time;
+	unsigned long long                           thread_overflows;
+	RunningStatistics                            thread_statistics;
+	RunningStatistics                            thread_batch_statistics;
+
 	BigInteger         results_sum;
-	unsigned int       results_n;
+	unsigned long long results_n;
 	unsigned long long results_time;
+	unsigned long long results_overflows;
+	RunningStatistics  results_statistics;
+	RunningStatistics  results_batch_statistics;
 	
 	BigInteger avg;
 
+	auto start_time = std::chrono::steady_clock::now();
+
+	bool stopping = false;
+
+	// Sample count at which the target precision is checked next, and the number of checks in a row that met it
+	unsigned long long next_check_n       = MIN_STOPPING_SAMPLE_COUNT;
+	int                passed_check_count = 0;
+
 	while (true) {
 		using namespace std::chrono_literals;
 
-		std::this_thread::sleep_for(1s);
+		// Once stopping, wait until every thread has published its last batch so that the final report covers all estimates
+		std::this_thread::sleep_for(stopping ? 10ms : 1s);
+
+		bool finished = stopping;
+
+		results_sum        = 0;
+		results_n          = 0;
+		results_time       = 0;
+		results_overflows  = 0;
+		results_statistics       = RunningStatistics();
+		results_batch_statistics = RunningStatistics();
 
-		results.mutex.lock();
-		{
-			results_sum  = results.sum;
-			results_n    = results.n;
-			results_time = results.time;
+		// Combine consistent snapshots of every thread, the threads keep running while this happens
+		for (int i = 0; i < thread_count; i++) {
+			finished &= results[i].is_finished();
+
+			results[i].snapshot(thread_sum, thread_n, thread_time, thread_overflows, thread_statistics, thread_batch_statistics);
+
+			results_sum       += thread_sum.to_big_integer();
+			results_n         += thread_n;
+			results_time      += thread_time;
+			results_overflows += thread_overflows;
+
+			results_statistics      .merge(thread_statistics);
+			results_batch_statistics.merge(thread_batch_statistics);
 		}
-		results.mutex.unlock();
+
+		if (stopping && !finished) continue;
 
 		if (results_n > 0) { // Avoid division by 0
-			avg = (results_sum * latin_rectangle_count) / results_n;
+			avg = (results_sum * scale) / FixedInteger<1>(results_n).to_big_integer();
+
+			double elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+			// Half width of the 95% confidence interval, relative to the average
+			double relative_standard_error = results_batch_statistics.get_relative_standard_error();
+			double relative_half_width     = 1.96 * relative_standard_error;
+
+			// The average above is rounded down to an integer, which matters for the small sizes
+			double avg_double = results_sum.get_d() * scale.get_d() / results_n;
+
+			// Samples with a relative variance of 1 that would give the same precision, per second
+			double sample_relative_standard_error = results_statistics.get_relative_standard_error();
+			double effective_samples_per_second   = 1.0 / (sample_relative_standard_error * sample_relative_standard_error) / elapsed_seconds;
+
+			printf(  "%llu: Avg: ",                                      results_n); mpz_out_str(stdout, 10, avg.__get_mp());
+			printf("\n%llu: Tru: %s\n\n", results_n, true_value_str.c_str());
+			printf("Relative standard error: %.3f%% over %llu batch means, 95%% confidence interval: [%.6e, %.6e] (+-%.3f%%)\n",
+				100.0 * relative_standard_error,
+				results_batch_statistics.count,
+				avg_double * (1.0 - relative_half_width),
+				avg_double * (1.0 + relative_half_width),
+				100.0 * relative_half_width
+			);
+			printf("Avg Iteration Time: %llu us, %.0f samples/s, %.1f effective samples/s\n\n", results_time / results_n, results_n / elapsed_seconds, effective_samples_per_second);
+
+			if (results_overflows > 0) {
+				printf("%llu estimates overflowed and were counted as 0, the average is biased low\n\n", results_overflows);
+			}
+
+			if (finished) return;
+
+			if (target_precision > 0.0 && results_n >= next_check_n) {
+				next_check_n = (unsigned long long)(results_n * STOPPING_CHECK_GROWTH);
+
+				passed_check_count = relative_half_width <= target_precision ? passed_check_count + 1 : 0;
 
-			printf(  "%u: Avg: ",                                      results_n); mpz_out_str(stdout, 10, avg.__get_mp());
-			printf("\n%u: Tru: %s\n\nAvg Iteration Time: %llu us\n\n", results_n,  true_value_str.c_str(), results_time / results_n);
+				if (passed_check_count >= STOPPING_CHECK_COUNT) {
+					printf("Reached the target precision, stopping\n\n");
+
+					for (int i = 0; i < thread_count; i++) {
+						results[i].request_stop();
+					}
+
+					stopping = true;
+				}
+			}
 		}
 	}
-}
\ No newline at end of file
+}
+
+// Explicit instantiations for all supported sizes, these need to match the dispatch table in Main.cpp
+template struct SudokuEstimator<2, 2>;
+template struct SudokuEstimator<2, 3>;
+template struct SudokuEstimator<2, 4>;
+template struct SudokuEstimator<3, 3>;
+template struct SudokuEstimator<3, 4>;
+template struct SudokuEstimator<4, 4>;
+
+template void report_results<2, 2>(int random_walk_length, SudokuEstimator<2, 2>::Results * results, int thread_count, double target_precision);
+template void report_results<2, 3>(int random_walk_length, SudokuEstimator<2, 3>::Results * results, int thread_count, double target_precision);
+template void report_results<2, 4>(int random_walk_length, SudokuEstimator<2, 4>::Results * results, int thread_count, double target_precision);
+template void report_results<3, 3>(int random_walk_length, SudokuEstimator<3, 3>::Results * results, int thread_count, double target_precision);
+template void report_results<3, 4>(int random_walk_length, SudokuEstimator<3, 4>::Results * results, int thread_count, double target_precision);
+template void report_results<4, 4>(int random_walk_length, SudokuEstimator<4, 4>::Results * results, int thread_count, double target_precision);
\ No newline at end of file
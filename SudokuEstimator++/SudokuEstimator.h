@@ -1,52 +1,375 @@
 #pragma once
+#include <atomic>
 #include <random>
+#include <type_traits>
 
 #include "BigInteger.h"
+#include "FixedInteger.h"
+#include "ThreadResults.h"
+#include "SubtreePool.h"
+#include "TranspositionTable.h"
 
 #include "Sudoku.h"
+#include "SudokuBitmask.h"
+#include "SudokuBuckets.h"
 #include "SudokuTraverser.h"
+#include "LatinRectangle.h"
+#include "AC3.h"
+#include "HiddenSingles.h"
+#include "Proposal.h"
+#include "KnuthBatch.h"
+#include "Random.h"
 
-constexpr int N = 4;
-constexpr int M = 4;
-constexpr int random_walk_length = 55;
+constexpr int BATCH_SIZE = 100;
 
-static_assert(N == Generated::N && M == Generated::M, "N and M should match the generated code! The code can be regenerated with different N and M using 'Python Scripts/code_generator.py'");
-static_assert(N <= M, "Values of N and M should be swapped such that N <= M");
+// The estimates are heavy tailed, so the variance is underestimated until enough samples hit the tail, a run never stops before this
+constexpr int MIN_STOPPING_SAMPLE_COUNT = 100000;
 
-constexpr int BATCH_SIZE = 100;
+// The confidence interval is computed from the means of batches of CONFIDENCE_BATCH_SIZE estimates, which are much closer to
+// normally distributed than the estimates themselves. It needs to be a multiple of BATCH_SIZE.
+constexpr int CONFIDENCE_BATCH_SIZE = 10 * BATCH_SIZE;
+
+// Checking the confidence interval over and over would stop a run on the first lucky dip of the variance.
+// The target precision is therefore only checked whenever the sample count has grown by a factor STOPPING_CHECK_GROWTH,
+// and a run only stops once the target was met at STOPPING_CHECK_COUNT checks in a row.
+constexpr double STOPPING_CHECK_GROWTH = 1.25;
+constexpr int    STOPPING_CHECK_COUNT  = 3;
+
+// Selects the state representation used by the estimator
+// The counter layout (Sudoku.h) uses per (cell, value) constraint counters, the bitmask layout (SudokuBitmask.h) uses per row, column and block masks.
+// The bitmask layout is on par for sizes up to 3x3, but on 4x4 the most constrained traverser has to recompute
+// the domain size of every empty cell on every node, which makes it about 1.3x slower than the counter layout.
+constexpr bool use_bitmask_layout = false;
+
+// Selects how the backtracker finds the most constrained cell
+// MostConstrainedTraverser scans all empty cells on every node, BucketTraverser keeps the empty cells of the counter layout
+// in buckets by domain size (see SudokuBuckets.h) and reads the cell off the lowest non-empty bucket.
+// Picking a cell becomes about 10x cheaper, but every set and reset has to move the peers between buckets, which costs more
+// than the scan saves: the scan usually stops early at a domain of size 1. With the bucket traverser, 3x3 with s = 6 takes
+// about 1.3x as long per sample and 4x4 with s = 55 about 2x as long.
+constexpr bool use_bucket_traverser = false;
+
+static_assert(!(use_bucket_traverser && use_bitmask_layout), "The bucket traverser is built on top of the counter layout");
+
+// Selects how the Latin Rectangle in every Nth row is sampled, see LatinRectangle.h
+// The rejection sampler restarts until the shuffled rows form a Latin Rectangle, which takes about 2.7 us on 3x3 and 120 us on 4x4.
+// The sequential sampler never restarts and takes about 1 us on 3x3 and 5 us on 4x4, but weights its estimates.
+constexpr LatinRectangle::Sampler latin_rectangle_sampler = LatinRectangle::Sampler::SEQUENTIAL;
+
+// Selects how Knuth's algorithm picks the value of every cell of the random walk, see Proposal.h
+// The weighted proposals make a sample 2x to 5x as expensive, so they only pay off where they cut the variance by more than that.
+// Measured as relative variance times time per sample over 40000 samples, lower is better (uniform / viable / peer domains):
+// 2x3 59 / 25 / 22, 2x4 5200 / 1600 / 1200, 3x3 1600 / 2500 / 1400, 3x4 81000 / 480000 / 75000.
+// The estimates are heavy tailed, so these numbers vary by up to a factor of 4 between runs, and on 4x4 the time per sample
+// is dominated by backtracking. Only on the small sizes does a weighted proposal clearly win, and the batched random walk
+// (see use_batched_knuth) makes uniform samples about 1.5x cheaper, so uniform stays the default.
+constexpr Knuth::Proposal knuth_proposal = Knuth::Proposal::UNIFORM;
+
+// Takes the random walks of KNUTH_BATCH_LANES samples together, see KnuthBatch.h
+// The walks run on bitmask domains in structure of arrays form, updated one live lane at a time by default, and only the samples that survive their walk are replayed
+// into the grid for arc consistency and backtracking. A lane that runs into an empty domain is masked off for the rest of the walk.
+// Most walks die (85% on 2x3, 99% on 2x4, 68% on 3x3), so this skips most of the work on the counter layout.
+// With the default random walk lengths a sample takes 1.3 us instead of 1.8 us on 2x3, 2.0 us instead of 3.2 us on 2x4,
+// 3.7 us instead of 5.4 us on 3x3 and 7.4 us instead of 11.6 us on 3x4, about a third of which is sampling the Latin Rectangle.
+// On 4x4 backtracking dominates. The estimates have the same distribution, only the random numbers are drawn in a different order.
+// Only the uniform proposal is supported.
+constexpr bool use_batched_knuth = true;
+constexpr int  KNUTH_BATCH_LANES = 16;
+
+static_assert(!use_batched_knuth || knuth_proposal == Knuth::Proposal::UNIFORM, "The batched random walk only supports the uniform proposal");
 
-using Sudoku_NxM = Sudoku<N, M>; // Assertions cannot contain commas because they are macros, this alias is used to circumvent this.
+// Selects how arc consistency is enforced between the random walk and backtracking, see AC3.h
+// ac3() enqueues every arc of the grid on every sample, ac3_incremental() only starts from the empty cells with a single value left.
+// Both reach the same fixpoint, so the estimates are identical. The incremental pass takes about 1 us instead of 7.8 us on 3x3
+// and 1.6 us instead of 12 us on 3x4, which makes a whole sample with the default random walk lengths about 1.5x faster.
+constexpr bool use_incremental_ac3 = true;
 
+// Lets the backtracker branch on a hidden single, a value that only one cell of a row, column or block can take, see HiddenSingles.h
+// It is only looked for at nodes where the most constrained cell has more than one value left, and a unit that misses a value
+// altogether ends the node. The estimates are identical, but on 4x4 with s = 55 a sample takes about 4 ms instead of 20 ms.
+// The scan over all units costs more than the nodes it saves on the smaller sizes, so it is only enabled from HIDDEN_SINGLES_MIN_SIZE:
+// 2x3 to 3x4 with their default random walk lengths take 1% to 5% longer, 3x3 with s = 10 visits 18% fewer nodes but takes 19% longer,
+// with s = 6 46% fewer but 27% longer, and 3x4 with s = 20 25% fewer but 6% longer.
+constexpr bool use_hidden_singles      = true;
+constexpr int  HIDDEN_SINGLES_MIN_SIZE = 16;
+
+// Size of the transposition table, see TranspositionTable.h
+// The switch use_transposition_table lives in Zobrist.h, as the grids only keep their hash up to date when it is enabled
+constexpr int TRANSPOSITION_TABLE_BUCKET_COUNT = 1 << 14; // 64 byte buckets, 1 MB per thread
+
+// Counts the residual grid of a sample only once per symmetry class, see Symmetry.h
+// The solution count of every residual grid is stored in the transposition table under the hash of its canonical form,
+// so a later sample that reaches an equivalent grid reuses it.
+// On 2x2 95% of the residual grids hit, which makes a sample about 1.4x faster, but already on 2x3 with s = 3 only 0.3% hit
+// and none on larger sizes, where the canonical form costs more than it saves. It is disabled by default like the table itself.
+constexpr bool use_symmetry_cache = false;
+
+// Selects the backtracking engine used to count the solutions of the residual grid
+// The iterative engine keeps its own stack of (cell, untried values) frames instead of recursing, see backtrack_iterative().
+constexpr bool use_iterative_backtracker = true;
+
+// Large residual grids are split into subtrees that all estimator threads can help counting, see SubtreePool.h
+// Once the iterative backtracker has visited PARALLEL_BACKTRACK_SPLIT_NODE_COUNT nodes for a grid, the untried values of the
+// PARALLEL_BACKTRACK_SPLIT_FRAME_COUNT frames closest to the root are handed out, and so on every time after that.
+// The default random walk lengths almost never reach the threshold, it is meant for runs with a small s.
+constexpr bool use_parallel_backtracking            = true;
+constexpr int  PARALLEL_BACKTRACK_SPLIT_NODE_COUNT  = 4096;
+constexpr int  PARALLEL_BACKTRACK_SPLIT_FRAME_COUNT = 4;
+
+// Estimator for the number of N*M x N*M Sudoku grids.
+// The supported values of N and M are explicitly instantiated in SudokuEstimator.cpp,
+// Main.cpp selects one of them at startup.
+template<int N, int M>
 struct SudokuEstimator {
-private:
-	Sudoku<N, M> sudoku; // N*M x N*M Sudoku
+	static_assert(N <= M, "Values of N and M should be swapped such that N <= M");
 
-	MostConstrainedTraverser<N, M> traverser;
+	using SudokuState = std::conditional_t<use_bucket_traverser, SudokuBuckets<N, M>, std::conditional_t<use_bitmask_layout, SudokuBitmask<N, M>, Sudoku<N, M>>>;
+	using Traverser   = std::conditional_t<use_bucket_traverser, BucketTraverser<N, M>, MostConstrainedTraverser<N, M>>;
 
 	static constexpr int coordinate_count = Sudoku<N, M>::size * (Sudoku<N, M>::size - M);
+
+	// Upper bound on the number of bits of a single estimate.
+	// Within a row, every cell that is filled in excludes its value from the domains of the rest of the row.
+	// The product of the domain sizes over a row, and the number of ways to complete a row, are therefore at most (N*M)!.
+	// The first row is fixed, so with the uniform proposal any estimate is at most ((N*M)!)^(N*M - 1).
+	// The weighted proposals multiply by up to twice the domain size instead, see Knuth::get_weights(),
+	// which takes one more bit for every cell of the random walk. Since the proposal can be changed at runtime, this covers all of them.
+	static constexpr int estimate_bit_count = [] {
+		uint64_t factorial = 1;
+		for (int i = 2; i <= Sudoku<N, M>::size; i++) factorial *= i;
+
+		int factorial_bit_count = 0;
+		while (factorial >> factorial_bit_count) factorial_bit_count++;
+
+		return factorial_bit_count * (Sudoku<N, M>::size - 1) + coordinate_count;
+	}();
+
+	// Estimates are stored in fixed width integers on the stack, they are only promoted to BigIntegers when a batch is flushed
+	using Estimate = FixedInteger<(estimate_bit_count + 63) / 64>;
+
+	// Estimate as a double, scaled down by 2^(estimate_bit_count / 2) so that its square cannot overflow, for RunningStatistics
+	static inline double get_scaled_estimate(const Estimate & estimate) {
+		return ldexp(estimate.to_double(), -estimate_bit_count / 2);
+	}
+
+	// Every thread sums its own estimates, one extra limb leaves room for 2^64 samples
+	using Results = ThreadResults<(estimate_bit_count + 63) / 64 + 1>;
+
+	// Solutions of a residual grid that are counted by several threads
+	struct SubtreeGroup {
+		std::atomic<uint64_t> solution_count = 0;
+		std::atomic<int>      pending_count  = 0; // Number of subtrees that have not been counted yet
+	};
+
+	// Values of a cell whose solutions are counted by any thread, together with a copy of the grid they are counted in
+	struct SubtreeTask {
+		SudokuState    sudoku;
+		int            cell_index;
+		uint32_t       values;
+		SubtreeGroup * group;
+	};
+
+	using Subtrees = SubtreePool<SubtreeTask>;
+
+private:
+	SudokuState sudoku; // N*M x N*M Sudoku
+
+	Traverser traverser;
+
 	int coordinates[coordinate_count];
 
-	static_assert(random_walk_length <= coordinate_count, "Length of the random walk cannot be longer than the available number of cells.");
+	// Number of cells that are filled in by Knuth's algorithm before switching to backtracking
+	int random_walk_length;
+
+	TranspositionTable transposition_table;
+
+	ArcQueue<N, M> arc_queue; // Used by ac3()
+
+	Estimate estimate;
+	uint64_t backtrack; // Every solution is counted one by one, so this cannot realistically overflow
+
+	// Number of estimates that did not fit in an Estimate, 'estimate_bit_count' should rule this out
+	uint64_t overflow_count = 0;
+
+	// Multiplies 'target' by 'factor', in release builds as well an estimate that overflows is counted and replaced by 0 instead of being truncated
+	// Returns false if it overflowed
+	inline bool multiply_estimate(Estimate & target, uint64_t factor) {
+		if (target.multiply_checked(factor)) return true;
+
+		target = 0;
+		overflow_count++;
+
+		return false;
+	}
+
+	uint64_t node_count = 0; // Number of backtracking nodes visited so far, used to weigh transposition table entries
 
-	BigInteger estimate;
-	BigInteger backtrack;
+	// Node of the iterative backtracker
+	// Every frame sets exactly one cell at a time, so the stack of frames doubles as the undo trail
+	struct BacktrackFrame {
+		int      cell_index;       // Cell that is branched on
+		uint32_t remaining_values; // Bitmask of the values in the domain of the cell that have not been tried yet
+		bool     complete;         // False if some of the values are counted elsewhere, then the count is not the count of the grid
 
-	// Variables used for uniform random number generation
-	std::random_device random_device;
-	std::mt19937       rng;
+		uint64_t backtrack_before;  // Solution count when the node was entered, used by the transposition table
+		uint64_t node_count_before; // Node count when the node was entered, used by the transposition table
+	};
+
+	// At most every cell is branched on once along a path
+	BacktrackFrame backtrack_stack[Sudoku<N, M>::size * Sudoku<N, M>::size];
+
+	// Shared by all threads of a run, nullptr if subtrees are never split off
+	Subtrees * subtrees     = nullptr;
+	int        thread_index = 0;
+
+	SubtreeGroup * split_group      = nullptr; // Group of the tree that is being counted, nullptr if it should not be split
+	uint64_t       split_node_count = 0;       // Value of 'node_count' at which the tree is split next
+	SudokuState    split_state;                // Grid at the root of the tree that is being split
+
+	// Used for uniform random number generation, every batch gets its own stream
+	Random::Generator rng;
+
+	// Whether the backtracker looks for hidden singles by default, see 'use_hidden_singles'
+	static constexpr bool default_hidden_singles = use_hidden_singles && Sudoku<N, M>::size >= HIDDEN_SINGLES_MIN_SIZE;
+
+	// Whether the backtracker looks for hidden singles, defaults to 'default_hidden_singles' but can be changed at runtime so that the
+	// benchmark can compare the node counts
+	bool hidden_singles = default_hidden_singles;
+
+	// Picks the cell to branch on at the node of the current grid, starting from the cell at 'traverser.index'
+	// Returns the values to try as a bitmask, which is 0 if the grid has no solutions
+	inline uint32_t select_branch(int & cell_index) {
+		cell_index = traverser.index;
+
+		uint32_t values = sudoku.get_domain_mask(cell_index);
+
+		// A cell with a single value is branched on right away, it is as cheap as a hidden single
+		if (hidden_singles && (values & (values - 1)) != 0) {
+			int value;
+
+			switch (HiddenSingles::find<N, M>(sudoku, cell_index, value)) {
+				case HiddenSingles::Result::DEAD_END:      return 0;
+				case HiddenSingles::Result::HIDDEN_SINGLE: return 1u << value;
+
+				default: break;
+			}
+		}
+
+		return values;
+	}
 
 	// Uses backtracking to count all possible valid Sudoku solutions, given the current configuration of the grid
 	void backtrack_with_forward_check();
 
+	// Same as backtrack_with_forward_check(), without recursion
+	// Branches on the cell at 'traverser.index' and adds the number of solutions to 'backtrack'
+	void backtrack_iterative();
+
+	// Pushes a frame for the cell at 'traverser.index', unless the transposition table already knows its count
+	void enter_frame(int & depth);
+
+	// Runs the iterative backtracker until the frame at the given depth and all frames above it are done
+	void run_frames(int depth);
+
+	// Hands out the untried values of the frames closest to the root as subtrees
+	void split_frames(int depth);
+
+	// Counts the solutions of a subtree that was split off by any thread, and deletes the task
+	void count_subtree(SubtreeTask * task);
+
+	// Same as backtrack_iterative(), but splits off subtrees of large trees and helps counting them
+	void backtrack_parallel();
+
+	// Counts the solutions of the residual grid, unless an equivalent grid was already counted
+	void backtrack_canonical();
+
+	// Counts the solutions of the residual grid with the selected engine
+	inline void backtrack_solutions() {
+		if constexpr (use_iterative_backtracker) {
+			if (subtrees != nullptr) {
+				backtrack_parallel();
+			} else {
+				backtrack_iterative();
+			}
+		} else {
+			backtrack_with_forward_check();
+		}
+	}
+
+	// Enforces arc consistency on the grid with the selected implementation, returns false if a domain became empty
+	inline bool enforce_arc_consistency() {
+		if constexpr (use_incremental_ac3) {
+			return ac3_incremental(&sudoku);
+		} else {
+			return ac3(&sudoku, arc_queue);
+		}
+	}
+
+	// Samples a random Latin Rectangle for every Nth row, and initializes the estimate with its weight
+	// Returns false if the sampler ran into a dead end, in which case the estimate is 0
+	bool sample_latin_rectangle(int rows[M][Sudoku<N, M>::size]);
+
+	// Fills every Nth row of the grid with the rows of a Latin Rectangle
+	void fill_rows(const int rows[M][Sudoku<N, M>::size]);
+
+	// Fills every Nth row with a random Latin Rectangle, and initializes the estimate with its weight
+	// Returns false if the sampler ran into a dead end, in which case the estimate is 0
+	bool fill_latin_rectangle();
+
+	// Proposal used by knuth(), defaults to 'knuth_proposal' but can be changed at runtime so that the benchmark can compare them
+	Knuth::Proposal proposal = knuth_proposal;
+
 	// Takes a random walk of length 'random_walk_length' through the tree of all possible Sudokus
 	void knuth();
 
+	// Random walk that picks every value in the domain with the same probability
+	void knuth_uniform();
+
+	// Random walk that picks values with a probability proportional to the weights of the given proposal
+	template<Knuth::Proposal PROPOSAL>
+	void knuth_weighted();
+
 	// Gives and estimate of the amount of valid Sudoku grids,
 	// using a combination of Knuth's algorithm and backtracking
 	void estimate_solution_count();
 
+	// Enforces arc consistency on the grid after the random walk and multiplies the estimate by its number of solutions
+	void count_residual_solutions();
+
+	// Random walk of a single lane of 'knuth_batch', kept so that the lane can be replayed into the grid
+	struct KnuthLane {
+		int rows[M][Sudoku<N, M>::size]; // Latin Rectangle
+
+		unsigned short cells [coordinate_count]; // Cells of the random walk, in order
+		unsigned char  values[coordinate_count]; // Values that were picked for them
+
+		uint64_t factor; // Product of the domain sizes that is not multiplied into the estimate yet
+	};
+
+	KnuthBatch<N, M, KNUTH_BATCH_LANES> knuth_batch;
+	KnuthLane                           knuth_lanes[KNUTH_BATCH_LANES];
+
+	// Same as calling estimate_solution_count() 'sample_count' times, at most KNUTH_BATCH_LANES, with the random walks taken together
+	void estimate_solution_counts(Estimate * estimates, int sample_count);
+
+	// The benchmarks time the individual steps of estimate_solution_count()
+	template<int, int> friend struct EstimatorBenchmark;
+
+	// The tuner runs pilot samples for different random walk lengths
+	template<int, int> friend struct RandomWalkTuner;
+
 public:
-	void run(int thread_index);
+	SudokuEstimator(int random_walk_length);
+
+	// Keeps estimating until a stop is requested through 'results', publishing the running totals to 'results' after every batch
+	// The random streams are derived from the seed and the thread index, so the same seed gives the same estimates
+	// Large residual grids are shared with the other threads through 'subtrees', which may be nullptr
+	void run(Results * results, Subtrees * subtrees, uint64_t seed, int thread_index);
 };
 
-void report_results();
\ No newline at end of file
+// Periodically prints the combined results of all threads, with the standard error and an approximate 95% confidence interval from batch means
+// If 'target_precision' is positive, the threads are stopped once the half width of the confidence interval relative to the
+// average was at most 'target_precision' at STOPPING_CHECK_COUNT checks in a row, and it returns after printing the final results.
+// Otherwise it never returns.
+template<int N, int M>
+void report_results(int random_walk_length, typename SudokuEstimator<N, M>::Results * results, int thread_count, double target_precision);
\ No newline at end of file
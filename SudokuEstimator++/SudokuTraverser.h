@@ -1,5 +1,7 @@
 #pragma once
+#include "Bits.h"
 #include "Sudoku.h"
+#include "SudokuBuckets.h"
 
 template<int N, int M>
 struct MostConstrainedTraverser {
@@ -9,14 +11,16 @@ struct MostConstrainedTraverser {
 		index = -1;
 	}
 
-	inline void seek_first(const Sudoku<N, M> * sudoku) {
+	template<template<int, int> typename SudokuType>
+	inline void seek_first(const SudokuType<N, M> * sudoku) {
 		move(sudoku);
 	}
 
-	inline bool move(const Sudoku<N, M> * sudoku) {
+	template<template<int, int> typename SudokuType>
+	inline bool move(const SudokuType<N, M> * sudoku) {
 		// If this is the case, it means there is at least 1 cell filled in, meaning not all domain sizes are N*M
 		// We can thus initialize smallest_domain with Sudoku<N, M>::size, saving 1 (potential) swap
-		assert(sudoku->empty_cells_length < Sudoku_NxM::size * Sudoku_NxM::size);
+		assert(sudoku->empty_cells_length < sudoku->size * sudoku->size);
 
 		int smallest_domain = Sudoku<N, M>::size;
 		int smallest_index = -1;
@@ -24,7 +28,7 @@ struct MostConstrainedTraverser {
 		// Check the domain sizes of all empty cells
 		for (int i = 0; i < sudoku->empty_cells_length; i++) {
 			int index       = sudoku->empty_cells[i];
-			int domain_size = sudoku->domain_sizes[index];
+			int domain_size = sudoku->get_domain_size(index);
 			
 			if (domain_size < smallest_domain) {
 				smallest_domain = domain_size;
@@ -41,4 +45,40 @@ struct MostConstrainedTraverser {
 		
 		return false;
 	}
-};
\ No newline at end of file
+};
+
+// Same choice of cell as MostConstrainedTraverser, but read from the domain size buckets of SudokuBuckets
+// Ties are broken by the lowest cell index instead of the order of the empty cell list, which changes the order
+// in which the backtracker visits the tree, but not the number of solutions it counts.
+template<int N, int M>
+struct BucketTraverser {
+	int index;
+
+	inline BucketTraverser() {
+		index = -1;
+	}
+
+	inline void seek_first(const SudokuBuckets<N, M> * sudoku) {
+		move(sudoku);
+	}
+
+	inline bool move(const SudokuBuckets<N, M> * sudoku) {
+		assert(sudoku->empty_cells_length < sudoku->size * sudoku->size);
+
+		// Cells with a domain of size N*M are never selected, like in MostConstrainedTraverser
+		for (int domain_size = 0; domain_size < Sudoku<N, M>::size; domain_size++) {
+			for (int w = 0; w < SudokuBuckets<N, M>::word_count; w++) {
+				uint64_t candidates = sudoku->buckets[domain_size][w];
+
+				if (candidates) {
+					index = w * 64 + Bits::count_trailing_zeros(candidates);
+
+					return false;
+				}
+			}
+		}
+
+		// If the Sudoku is completed, return true.
+		return true;
+	}
+};
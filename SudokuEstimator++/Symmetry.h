@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+
+#include "Zobrist.h"
+
+// Symmetries of N*M x N*M Sudokus that preserve the number of ways to complete a partial grid:
+// permuting the bands (groups of N rows), the rows within a band, the stacks (groups of M columns), the columns within a stack,
+// and relabeling the values.
+// The canonical form only reorders by invariants and relabels, instead of searching the whole group for the smallest image,
+// so two grids with the same canonical form are always equivalent, but not every pair of equivalent grids has the same form.
+// Rows and columns with the same number of filled in cells keep their relative order.
+namespace Symmetry {
+	// Orders lines (rows or columns) by descending number of filled in cells, first the groups of LINES_PER_GROUP lines
+	// by their total, then the lines within every group
+	template<int LINES_PER_GROUP, int GROUP_COUNT>
+	inline void order_lines(const int * counts, int * order) {
+		constexpr int line_count = LINES_PER_GROUP * GROUP_COUNT;
+
+		int groups      [GROUP_COUNT];
+		int group_counts[GROUP_COUNT] = { };
+
+		for (int i = 0; i < line_count; i++) group_counts[i / LINES_PER_GROUP] += counts[i];
+
+		// Insertion sorts, these are stable and the arrays hold at most 16 elements
+		for (int g = 0; g < GROUP_COUNT; g++) {
+			int j = g;
+			for (; j > 0 && group_counts[groups[j - 1]] < group_counts[g]; j--) groups[j] = groups[j - 1];
+			groups[j] = g;
+		}
+
+		for (int g = 0; g < GROUP_COUNT; g++) {
+			int * lines = order + g * LINES_PER_GROUP;
+			int   first = groups[g] * LINES_PER_GROUP;
+
+			for (int l = 0; l < LINES_PER_GROUP; l++) {
+				int line = first + l;
+
+				int j = l;
+				for (; j > 0 && counts[lines[j - 1]] < counts[line]; j--) lines[j] = lines[j - 1];
+				lines[j] = line;
+			}
+		}
+	}
+
+	// Zobrist hash of the canonical form of the filled in cells of the grid, see Zobrist.h
+	// The canonical form is a grid itself, so its hash can share a table with the hashes of plain grids
+	template<int N, int M, typename SudokuType>
+	inline uint64_t get_canonical_hash(const SudokuType & sudoku) {
+		constexpr int size = N * M;
+
+		int row_counts   [size] = { };
+		int column_counts[size] = { };
+
+		for (int y = 0; y < size; y++) {
+			for (int x = 0; x < size; x++) {
+				int filled = sudoku.grid[x + y * size] != 0;
+
+				row_counts   [y] += filled;
+				column_counts[x] += filled;
+			}
+		}
+
+		// Bands are N rows high and there are M of them, stacks are M columns wide and there are N of them
+		int rows   [size];
+		int columns[size];
+		order_lines<N, M>(row_counts,    rows);
+		order_lines<M, N>(column_counts, columns);
+
+		// Values are relabeled in the order in which they first appear in the reordered grid
+		int labels[size + 1] = { };
+		int label_count      = 0;
+
+		uint64_t hash = 0;
+
+		for (int y = 0; y < size; y++) {
+			for (int x = 0; x < size; x++) {
+				int value = sudoku.grid[columns[x] + rows[y] * size];
+				if (value == 0) continue;
+
+				if (labels[value] == 0) labels[value] = ++label_count;
+
+				hash ^= zobrist<N, M>.keys[x + y * size][labels[value] - 1];
+			}
+		}
+
+		return hash;
+	}
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include <atomic>
+
+#include "FixedInteger.h"
+#include "Statistics.h"
+
+// Results of a single estimator thread.
+// Every thread owns one of these and is the only one writing to it, the reporting thread reads them through a seqlock.
+// Each instance is aligned to a cache line, so threads never write to the same line and never have to wait for each other.
+template<int LIMBS>
+struct alignas(64) ThreadResults {
+	using Sum = FixedInteger<LIMBS>;
+
+private:
+	// Odd while the thread is publishing new results
+	std::atomic<unsigned int> sequence = 0;
+
+	// Atomics are only used so that reading them during a write is well defined, the seqlock makes sure torn reads are discarded
+	std::atomic<uint64_t>           sum[LIMBS] = { };
+	std::atomic<unsigned long long> n          = 0;
+	std::atomic<unsigned long long> time       = 0;
+	std::atomic<unsigned long long> overflows  = 0; // Estimates that overflowed and were counted as 0
+
+	// Mean and sum of squared differences of the scaled estimates, the count is 'n'
+	std::atomic<double> mean = 0.0;
+	std::atomic<double> m2   = 0.0;
+
+	// Same for the means of the batches of scaled estimates
+	std::atomic<unsigned long long> batch_count = 0;
+	std::atomic<double>             batch_mean  = 0.0;
+	std::atomic<double>             batch_m2    = 0.0;
+
+	// Set by the reporting thread once the run should end, and by the owning thread once it has published its last batch
+	std::atomic<bool> stop     = false;
+	std::atomic<bool> finished = false;
+
+public:
+	// Called by the owning thread only
+	inline void publish(const Sum & total_sum, unsigned long long total_n, unsigned long long total_time, unsigned long long total_overflows, const RunningStatistics & statistics, const RunningStatistics & batch_statistics) {
+		unsigned int current_sequence = sequence.load(std::memory_order_relaxed);
+
+		sequence.store(current_sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		for (int i = 0; i < LIMBS; i++) {
+			sum[i].store(total_sum.limbs[i], std::memory_order_relaxed);
+		}
+		n        .store(total_n,         std::memory_order_relaxed);
+		time     .store(total_time,      std::memory_order_relaxed);
+		overflows.store(total_overflows, std::memory_order_relaxed);
+		mean.store(statistics.mean, std::memory_order_relaxed);
+		m2  .store(statistics.m2,   std::memory_order_relaxed);
+		batch_count.store(batch_statistics.count, std::memory_order_relaxed);
+		batch_mean .store(batch_statistics.mean,  std::memory_order_relaxed);
+		batch_m2   .store(batch_statistics.m2,    std::memory_order_relaxed);
+
+		sequence.store(current_sequence + 2, std::memory_order_release);
+	}
+
+	// Can be called from any thread, retries until it has read a consistent snapshot
+	inline void snapshot(Sum & total_sum, unsigned long long & total_n, unsigned long long & total_time, unsigned long long & total_overflows, RunningStatistics & statistics, RunningStatistics & batch_statistics) const {
+		unsigned int sequence_before;
+		unsigned int sequence_after;
+
+		do {
+			sequence_before = sequence.load(std::memory_order_acquire);
+
+			for (int i = 0; i < LIMBS; i++) {
+				total_sum.limbs[i] = sum[i].load(std::memory_order_relaxed);
+			}
+			total_n         = n        .load(std::memory_order_relaxed);
+			total_time      = time     .load(std::memory_order_relaxed);
+			total_overflows = overflows.load(std::memory_order_relaxed);
+
+			statistics.count = total_n;
+			statistics.mean  = mean.load(std::memory_order_relaxed);
+			statistics.m2    = m2  .load(std::memory_order_relaxed);
+
+			batch_statistics.count = batch_count.load(std::memory_order_relaxed);
+			batch_statistics.mean  = batch_mean .load(std::memory_order_relaxed);
+			batch_statistics.m2    = batch_m2   .load(std::memory_order_relaxed);
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			sequence_after = sequence.load(std::memory_order_relaxed);
+		} while ((sequence_before & 1) || sequence_before != sequence_after);
+	}
+
+	inline void request_stop() {
+		stop.store(true, std::memory_order_relaxed);
+	}
+
+	// Checked by the owning thread after every batch
+	inline bool is_stop_requested() const {
+		return stop.load(std::memory_order_relaxed);
+	}
+
+	// Called by the owning thread once it stopped
+	inline void finish() {
+		finished.store(true, std::memory_order_release);
+	}
+
+	inline bool is_finished() const {
+		return finished.load(std::memory_order_acquire);
+	}
+};
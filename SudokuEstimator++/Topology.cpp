@@ -0,0 +1,374 @@
+#include "Topology.h"
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+#ifdef _WIN32
+#define VC_EXTRALEAN
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sched.h>
+#include <pthread.h>
+#include <filesystem>
+#endif
+
+namespace Topology {
+	const char * get_name(Policy policy) {
+		switch (policy) {
+			case Policy::CORE: return "core";
+			case Policy::NUMA: return "numa";
+			default:           return "smt";
+		}
+	}
+
+	bool parse_policy(const char * name, Policy * policy) {
+		if (strcmp(name, "core") == 0) { *policy = Policy::CORE; return true; }
+		if (strcmp(name, "smt")  == 0) { *policy = Policy::SMT;  return true; }
+		if (strcmp(name, "numa") == 0) { *policy = Policy::NUMA; return true; }
+
+		return false;
+	}
+
+	// Assigns dense indices to the physical cores and sorts the processors by node, core and id
+	static void finalize(std::vector<LogicalProcessor> & processors, std::vector<long long> & core_keys) {
+		std::vector<long long> unique_keys = core_keys;
+		std::sort(unique_keys.begin(), unique_keys.end());
+		unique_keys.erase(std::unique(unique_keys.begin(), unique_keys.end()), unique_keys.end());
+
+		for (size_t i = 0; i < processors.size(); i++) {
+			processors[i].core = (int)(std::lower_bound(unique_keys.begin(), unique_keys.end(), core_keys[i]) - unique_keys.begin());
+		}
+
+		std::sort(processors.begin(), processors.end(), [](const LogicalProcessor & a, const LogicalProcessor & b) {
+			if (a.node != b.node) return a.node < b.node;
+			if (a.core != b.core) return a.core < b.core;
+
+			return a.id < b.id;
+		});
+	}
+
+#ifdef _WIN32
+	std::vector<LogicalProcessor> detect() {
+		DWORD_PTR process_mask;
+		DWORD_PTR system_mask;
+		GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask);
+
+		DWORD buffer_length = 0;
+		GetLogicalProcessorInformation(nullptr, &buffer_length);
+
+		std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info(buffer_length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+		GetLogicalProcessorInformation(info.data(), &buffer_length);
+
+		std::vector<LogicalProcessor> processors;
+		std::vector<long long>        core_keys;
+
+		constexpr int bit_count = 8 * sizeof(DWORD_PTR);
+
+		for (int id = 0; id < bit_count; id++) {
+			DWORD_PTR bit = (DWORD_PTR)1 << id;
+			if ((process_mask & bit) == 0) continue;
+
+			LogicalProcessor processor = { id, 0, 0 };
+			long long        core_key  = id;
+
+			for (size_t i = 0; i < info.size(); i++) {
+				if ((info[i].ProcessorMask & bit) == 0) continue;
+
+				if (info[i].Relationship == LOGICAL_PROCESSOR_RELATIONSHIP::RelationProcessorCore) {
+					core_key = bit_count + (long long)i;
+				} else if (info[i].Relationship == LOGICAL_PROCESSOR_RELATIONSHIP::RelationNumaNode) {
+					processor.node = info[i].NumaNode.NodeNumber;
+				}
+			}
+
+			processors.push_back(processor);
+			core_keys .push_back(core_key);
+		}
+
+		finalize(processors, core_keys);
+
+		return processors;
+	}
+
+	int get_cpu_quota() {
+		return -1;
+	}
+
+	bool pin_current_thread(const Worker & worker) {
+		DWORD_PTR mask = 0;
+		for (int id : worker.processors) {
+			mask |= (DWORD_PTR)1 << id;
+		}
+
+		return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+	}
+#else
+	// Reads a single integer from a (sysfs) file, returns 'fallback' if the file does not exist
+	static long long read_integer(const char * path, long long fallback) {
+		FILE * file = fopen(path, "r");
+		if (file == nullptr) return fallback;
+
+		long long value;
+		if (fscanf(file, "%lld", &value) != 1) value = fallback;
+
+		fclose(file);
+
+		return value;
+	}
+
+	// Parses a sysfs cpu list such as "0-3,8-11"
+	static std::vector<int> read_cpu_list(const char * path) {
+		std::vector<int> cpus;
+
+		FILE * file = fopen(path, "r");
+		if (file == nullptr) return cpus;
+
+		int first;
+		while (fscanf(file, "%d", &first) == 1) {
+			int last = first;
+
+			int separator = fgetc(file);
+			if (separator == '-') {
+				if (fscanf(file, "%d", &last) != 1) break;
+
+				separator = fgetc(file);
+			}
+
+			for (int cpu = first; cpu <= last; cpu++) {
+				cpus.push_back(cpu);
+			}
+
+			if (separator != ',') break;
+		}
+
+		fclose(file);
+
+		return cpus;
+	}
+
+	std::vector<LogicalProcessor> detect() {
+		cpu_set_t allowed;
+		CPU_ZERO(&allowed);
+
+		if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+			printf("Unable to query the affinity of this process!\n");
+
+			abort();
+		}
+
+		// NUMA node of every cpu, cpus that are not listed under any node belong to node 0
+		std::vector<int> cpu_nodes(CPU_SETSIZE, 0);
+
+		std::error_code error;
+		for (const auto & entry : std::filesystem::directory_iterator("/sys/devices/system/node", error)) {
+			int node;
+			if (sscanf(entry.path().filename().c_str(), "node%d", &node) != 1) continue;
+
+			for (int cpu : read_cpu_list((entry.path() / "cpulist").c_str())) {
+				if (cpu < CPU_SETSIZE) cpu_nodes[cpu] = node;
+			}
+		}
+
+		std::vector<LogicalProcessor> processors;
+		std::vector<long long>        core_keys;
+
+		for (int id = 0; id < CPU_SETSIZE; id++) {
+			if (!CPU_ISSET(id, &allowed)) continue;
+
+			char path[128];
+
+			// Cores are identified by their package and core id, if the topology is unknown every cpu is its own core
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", id);
+			long long package = read_integer(path, 0);
+
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/core_id", id);
+			long long core_id = read_integer(path, -1);
+
+			processors.push_back({ id, 0, cpu_nodes[id] });
+			core_keys .push_back(core_id == -1 ? (1ll << 40) + id : (package << 20) + core_id);
+		}
+
+		finalize(processors, core_keys);
+
+		return processors;
+	}
+
+	// Converts a CFS quota and period to a number of processors, rounded up, or -1 if there is no limit
+	static int get_processor_count(long long quota, long long period) {
+		if (quota <= 0 || period <= 0) return -1;
+
+		return (int)std::max(1ll, (quota + period - 1) / period);
+	}
+
+	// Walks from the cgroup 'cgroup_path' in the hierarchy mounted at 'root' up to 'root', and returns the smallest quota on the way,
+	// since the limit of every ancestor applies to this process as well. 'read_quota' returns the quota of a single cgroup directory.
+	// If the cgroup is not found under 'root', as inside a container where the cgroup of the container is mounted at the root, only the root is read.
+	template<typename ReadQuota>
+	static int get_smallest_quota(const std::filesystem::path & root, const char * cgroup_path, ReadQuota read_quota) {
+		std::filesystem::path relative_path = std::filesystem::path(cgroup_path).relative_path();
+		std::filesystem::path directory     = relative_path.empty() ? root : root / relative_path;
+
+		std::error_code error;
+		if (!std::filesystem::is_directory(directory, error)) directory = root;
+
+		int smallest = -1;
+
+		while (true) {
+			int quota = read_quota(directory);
+			if (quota > 0 && (smallest < 0 || quota < smallest)) smallest = quota;
+
+			if (directory == root || !directory.has_relative_path()) break;
+
+			directory = directory.parent_path();
+		}
+
+		return smallest;
+	}
+
+	int get_cpu_quota() {
+		// The cgroup of this process in the unified (v2) hierarchy is listed as "0::/path",
+		// in the v1 hierarchy of the cpu controller as "id:cpu,cpuacct:/path" or similar
+		char cgroup_path   [512] = "/";
+		char cgroup_path_v1[512] = "/";
+
+		FILE * file = fopen("/proc/self/cgroup", "r");
+		if (file != nullptr) {
+			char line[512];
+			while (fgets(line, sizeof(line), file)) {
+				char controllers[256];
+				char path       [512];
+				if (sscanf(line, "%*d:%255[^:]:%511s", controllers, path) == 2) {
+					for (char * controller = strtok(controllers, ","); controller != nullptr; controller = strtok(nullptr, ",")) {
+						if (strcmp(controller, "cpu") == 0) strcpy(cgroup_path_v1, path);
+					}
+				} else if (strncmp(line, "0::", 3) == 0) {
+					sscanf(line + 3, "%511s", cgroup_path);
+				}
+			}
+
+			fclose(file);
+		}
+
+		std::error_code error;
+
+		// cgroup v2
+		if (std::filesystem::exists("/sys/fs/cgroup/cgroup.controllers", error)) {
+			return get_smallest_quota("/sys/fs/cgroup", cgroup_path, [](const std::filesystem::path & directory) {
+				FILE * file = fopen((directory / "cpu.max").c_str(), "r");
+				if (file == nullptr) return -1; // The root cgroup has no limit
+
+				long long quota  = -1;
+				long long period = 100000;
+
+				char max[32];
+				if (fscanf(file, "%31s %lld", max, &period) == 2 && strcmp(max, "max") != 0) {
+					quota = atoll(max);
+				}
+
+				fclose(file);
+
+				return get_processor_count(quota, period);
+			});
+		}
+
+		// cgroup v1
+		return get_smallest_quota("/sys/fs/cgroup/cpu", cgroup_path_v1, [](const std::filesystem::path & directory) {
+			return get_processor_count(
+				read_integer((directory / "cpu.cfs_quota_us") .c_str(), -1),
+				read_integer((directory / "cpu.cfs_period_us").c_str(), 100000)
+			);
+		});
+	}
+
+	bool pin_current_thread(const Worker & worker) {
+		cpu_set_t set;
+		CPU_ZERO(&set);
+
+		for (int id : worker.processors) {
+			CPU_SET(id, &set);
+		}
+
+		return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+	}
+#endif
+
+	std::vector<Worker> place_workers(const std::vector<LogicalProcessor> & processors, Policy policy, int cpu_quota) {
+		std::vector<Worker> workers;
+
+		for (size_t i = 0; i < processors.size(); i++) {
+			const LogicalProcessor & processor = processors[i];
+
+			Worker worker;
+
+			switch (policy) {
+				case Policy::CORE: {
+					// The processors are sorted by core, so only the first processor of every core starts a worker
+					if (i > 0 && processors[i - 1].core == processor.core) continue;
+
+					for (const LogicalProcessor & sibling : processors) {
+						if (sibling.core == processor.core) worker.processors.push_back(sibling.id);
+					}
+
+					break;
+				}
+
+				case Policy::SMT: {
+					worker.processors.push_back(processor.id);
+
+					break;
+				}
+
+				case Policy::NUMA: {
+					for (const LogicalProcessor & neighbour : processors) {
+						if (neighbour.node == processor.node) worker.processors.push_back(neighbour.id);
+					}
+
+					break;
+				}
+			}
+
+			workers.push_back(worker);
+		}
+
+		// The processors are sorted by node, so this fills up the first nodes
+		if (cpu_quota > 0 && workers.size() > (size_t)cpu_quota) {
+			workers.resize(cpu_quota);
+		}
+
+		return workers;
+	}
+
+	void print_placement(const std::vector<LogicalProcessor> & processors, const std::vector<Worker> & workers, Policy policy, int cpu_quota) {
+		int core_count = 0;
+		int node_count = 0;
+
+		for (const LogicalProcessor & processor : processors) {
+			core_count = std::max(core_count, processor.core + 1);
+			node_count = std::max(node_count, processor.node + 1);
+		}
+
+		printf("Found %zu logical processors on %u cores and %u NUMA nodes", processors.size(), core_count, node_count);
+
+		if (cpu_quota > 0) {
+			printf(", limited to %u processors by the CPU quota\n", cpu_quota);
+		} else {
+			printf("\n");
+		}
+
+		printf("Placing %zu workers using the %s policy:\n", workers.size(), get_name(policy));
+
+		for (size_t i = 0; i < workers.size(); i++) {
+			printf("  Worker %2zu: processors", i);
+
+			for (int id : workers[i].processors) {
+				printf(" %u", id);
+			}
+
+			printf("\n");
+		}
+
+		printf("\n");
+	}
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include <vector>
+
+// Discovers which logical processors this process may run on, and decides where the estimator threads are placed.
+// On Linux this uses sysfs, sched_getaffinity and the cgroup CPU quota, on Windows GetLogicalProcessorInformation.
+namespace Topology {
+	struct LogicalProcessor {
+		int id;   // Operating system index of the logical processor
+		int core; // Index of the physical core it belongs to
+		int node; // NUMA node it belongs to
+	};
+
+	enum struct Policy {
+		CORE, // One worker per physical core, allowed to run on all SMT siblings of that core
+		SMT,  // One worker per logical processor, pinned to that logical processor
+		NUMA  // One worker per logical processor, filling up one NUMA node before the next, allowed to run anywhere on its node
+	};
+
+	const char * get_name(Policy policy);
+
+	// Parses a policy name as given on the command line, returns false if the name is unknown
+	bool parse_policy(const char * name, Policy * policy);
+
+	// Returns the logical processors this process is allowed to run on, sorted by NUMA node, then core, then id
+	std::vector<LogicalProcessor> detect();
+
+	// Returns the number of processors worth of CPU time this process is allowed to use by its cgroup and its ancestors, or -1 if unlimited
+	int get_cpu_quota();
+
+	// Set of logical processors a single worker is allowed to run on
+	struct Worker {
+		std::vector<int> processors;
+	};
+
+	// Decides how many workers to start, and where to run them
+	// The number of workers is limited by the CPU quota, if there is one
+	std::vector<Worker> place_workers(const std::vector<LogicalProcessor> & processors, Policy policy, int cpu_quota);
+
+	void print_placement(const std::vector<LogicalProcessor> & processors, const std::vector<Worker> & workers, Policy policy, int cpu_quota);
+
+	// Restricts the calling thread to the processors of the given worker, returns false on failure
+	bool pin_current_thread(const Worker & worker);
+};
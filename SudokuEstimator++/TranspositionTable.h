@@ -0,0 +1,101 @@
+#pragma once
+#include <cstdint>
+#include <cassert>
+
+// Bounded cache of the number of solutions of residual grids, keyed on their Zobrist hash (see Zobrist.h).
+// The number of ways to complete a grid only depends on the values in it, so entries stay valid across samples.
+// Every estimator owns its own table, so no synchronization is needed.
+// Entries are grouped into buckets of one cache line, a lookup or store touches a single line.
+// A store replaces the entry of the bucket whose subtree was the cheapest to count, since that one is the cheapest to recount.
+// Keys are full 64 bit hashes, a false hit requires a collision between two grids with a probability of about 2^-64 per lookup.
+struct TranspositionTable {
+	static constexpr int BUCKET_SIZE = 2;
+
+	struct Entry {
+		uint64_t key;
+		uint64_t solution_count;
+		uint64_t node_count; // Number of backtracking nodes the subtree took, 0 for unused entries
+	};
+
+	struct alignas(64) Bucket {
+		Entry entries[BUCKET_SIZE];
+	};
+
+	static_assert(sizeof(Bucket) == 64, "A bucket should fill exactly one cache line");
+
+	// Counters since the last call to reset_statistics()
+	struct Statistics {
+		uint64_t lookup_count     = 0;
+		uint64_t hit_count        = 0;
+		uint64_t saved_node_count = 0; // Number of backtracking nodes that hits did not have to visit again
+	};
+
+private:
+	Bucket * buckets;
+	uint64_t bucket_mask;
+
+public:
+	Statistics statistics;
+
+	// 'bucket_count' should be a power of two
+	inline TranspositionTable(int bucket_count) {
+		assert(bucket_count > 0 && (bucket_count & (bucket_count - 1)) == 0);
+
+		buckets     = new Bucket[bucket_count]();
+		bucket_mask = bucket_count - 1;
+	}
+
+	inline ~TranspositionTable() {
+		delete[] buckets;
+	}
+
+	TranspositionTable(const TranspositionTable &) = delete;
+	TranspositionTable & operator=(const TranspositionTable &) = delete;
+
+	// Returns true and sets 'solution_count' if the grid with the given hash is in the table
+	inline bool lookup(uint64_t key, uint64_t & solution_count) {
+		const Bucket & bucket = buckets[key & bucket_mask];
+
+		statistics.lookup_count++;
+
+		for (int i = 0; i < BUCKET_SIZE; i++) {
+			const Entry & entry = bucket.entries[i];
+
+			if (entry.key == key && entry.node_count != 0) {
+				statistics.hit_count++;
+				statistics.saved_node_count += entry.node_count;
+
+				solution_count = entry.solution_count;
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	inline void store(uint64_t key, uint64_t solution_count, uint64_t node_count) {
+		assert(node_count > 0);
+
+		Bucket & bucket = buckets[key & bucket_mask];
+
+		Entry * victim = &bucket.entries[0];
+
+		for (int i = 1; i < BUCKET_SIZE; i++) {
+			if (bucket.entries[i].node_count < victim->node_count) victim = &bucket.entries[i];
+		}
+
+		victim->key            = key;
+		victim->solution_count = solution_count;
+		victim->node_count     = node_count;
+	}
+
+	// Removes all entries
+	inline void clear() {
+		for (uint64_t i = 0; i <= bucket_mask; i++) buckets[i] = Bucket();
+	}
+
+	inline void reset_statistics() {
+		statistics = Statistics();
+	}
+};
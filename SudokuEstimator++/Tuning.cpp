@@ -0,0 +1,134 @@
+#include "Tuning.h"
+
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+#include "SudokuEstimator.h"
+#include "Statistics.h"
+
+template<int N, int M>
+struct RandomWalkTuner {
+	using Estimator = SudokuEstimator<N, M>;
+
+	// Pilot samples use a thread index that no estimator thread has, so their streams never overlap with the ones of the run
+	static constexpr uint64_t TUNING_STREAM = ~0ull;
+
+	struct Candidate {
+		int random_walk_length;
+
+		RunningStatistics statistics;
+
+		unsigned long long nonzero_count = 0;
+
+		double us_per_sample;
+	};
+
+	// Runs pilot samples with the given random walk length until the time budget of a candidate is used up,
+	// and past it until TUNING_MIN_NONZERO_COUNT estimates are non-zero or TUNING_MAX_SECONDS_PER_CANDIDATE have passed
+	static Candidate run_pilot(int random_walk_length, uint64_t seed) {
+		Candidate candidate;
+		candidate.random_walk_length = random_walk_length;
+
+		Estimator * estimator = new Estimator(random_walk_length);
+		estimator->rng = Random::Generator(Random::derive_key(seed, TUNING_STREAM, random_walk_length));
+
+		auto start_time = std::chrono::high_resolution_clock::now();
+
+		double elapsed_seconds;
+
+		do {
+			// Pilot samples are taken the same way as the samples of the run, so that their times compare
+			if constexpr (use_batched_knuth) {
+				typename Estimator::Estimate estimates[KNUTH_BATCH_LANES];
+				estimator->estimate_solution_counts(estimates, KNUTH_BATCH_LANES);
+
+				for (const typename Estimator::Estimate & estimate : estimates) {
+					add_estimate(candidate, estimate);
+				}
+			} else {
+				estimator->estimate_solution_count();
+
+				add_estimate(candidate, estimator->estimate);
+			}
+
+			elapsed_seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+		} while (elapsed_seconds < TUNING_SECONDS_PER_CANDIDATE || (candidate.nonzero_count < TUNING_MIN_NONZERO_COUNT && elapsed_seconds < TUNING_MAX_SECONDS_PER_CANDIDATE));
+
+		candidate.us_per_sample = 1e6 * elapsed_seconds / candidate.statistics.count;
+
+		delete estimator;
+
+		return candidate;
+	}
+
+	static inline void add_estimate(Candidate & candidate, const typename Estimator::Estimate & estimate) {
+		double scaled_estimate = Estimator::get_scaled_estimate(estimate);
+
+		candidate.statistics.add(scaled_estimate);
+
+		if (scaled_estimate > 0.0) candidate.nonzero_count++;
+	}
+
+	static int tune(int random_walk_length, uint64_t seed) {
+		// Evenly spaced candidates around the given length, clamped to the valid range
+		int step = std::max(1, (random_walk_length + 4) / 8);
+
+		int longest  = std::min(Estimator::coordinate_count, random_walk_length + step * (TUNING_CANDIDATE_COUNT / 2));
+		int shortest = std::max(0, longest - step * (TUNING_CANDIDATE_COUNT - 1));
+
+		printf("Tuning the random walk length of %ux%u, %.1f seconds of pilot samples for every s from %u down to %u in steps of %u\n", N, M, TUNING_SECONDS_PER_CANDIDATE, longest, shortest, step);
+
+		int    best_random_walk_length = random_walk_length;
+		double best_cost               = INFINITY;
+
+		for (int s = longest; s >= shortest; s -= step) {
+			Candidate candidate = run_pilot(s, seed);
+
+			double relative_variance = candidate.statistics.get_relative_variance();
+			double cost              = relative_variance * candidate.us_per_sample;
+
+			printf("  s = %3u: %8llu samples, %6llu non-zero, %12.1f us/sample, relative variance %10.1f, %12.1f us\n", s, candidate.statistics.count, candidate.nonzero_count, candidate.us_per_sample, relative_variance, cost);
+
+			// Shorter walks only take longer per sample, and too few samples give no reliable variance
+			if (candidate.statistics.count < TUNING_MIN_SAMPLE_COUNT) {
+				printf("  Too few samples, shorter random walks are skipped\n");
+
+				break;
+			}
+
+			// Without enough non-zero estimates the relative variance is INF, 0 or far off, so the candidate is not picked
+			if (candidate.nonzero_count < TUNING_MIN_NONZERO_COUNT || !std::isfinite(cost) || cost <= 0.0) {
+				printf("  Too few non-zero estimates, s = %u is not picked\n", s);
+
+				continue;
+			}
+
+			if (cost < best_cost) {
+				best_cost               = cost;
+				best_random_walk_length = s;
+			}
+		}
+
+		if (best_cost == INFINITY) {
+			printf("No candidate had enough non-zero estimates, keeping s = %u\n", random_walk_length);
+		}
+
+		printf("Using random walks of length %u\n\n", best_random_walk_length);
+
+		return best_random_walk_length;
+	}
+};
+
+template<int N, int M>
+int tune_random_walk_length(int random_walk_length, uint64_t seed) {
+	return RandomWalkTuner<N, M>::tune(random_walk_length, seed);
+}
+
+// Explicit instantiations for all supported sizes, these need to match the dispatch table in Main.cpp
+template int tune_random_walk_length<2, 2>(int random_walk_length, uint64_t seed);
+template int tune_random_walk_length<2, 3>(int random_walk_length, uint64_t seed);
+template int tune_random_walk_length<2, 4>(int random_walk_length, uint64_t seed);
+template int tune_random_walk_length<3, 3>(int random_walk_length, uint64_t seed);
+template int tune_random_walk_length<3, 4>(int random_walk_length, uint64_t seed);
+template int tune_random_walk_length<4, 4>(int random_walk_length, uint64_t seed);
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+
+// Time spent on the pilot samples of every candidate random walk length
+constexpr double TUNING_SECONDS_PER_CANDIDATE = 2.0;
+
+// A candidate needs at least this many pilot samples, shorter random walks are not tried once a candidate falls short of it
+constexpr int TUNING_MIN_SAMPLE_COUNT = 100;
+
+// A candidate keeps taking pilot samples past its time budget until this many of its estimates are non-zero,
+// as the relative variance of a handful of non-zero estimates says little. On 4x4 s = 62 needs about 120000 pilot samples
+// for 30 non-zero estimates, and with s = 69 and longer not one of 500000 is non-zero, so 2 seconds gave relative variances of 0 or INF.
+// Candidates that still fall short after the longer time limit are not picked.
+constexpr int    TUNING_MIN_NONZERO_COUNT         = 30;
+constexpr double TUNING_MAX_SECONDS_PER_CANDIDATE = 10.0;
+
+// Number of random walk lengths that are tried around the given one
+constexpr int TUNING_CANDIDATE_COUNT = 9;
+
+// Runs pilot samples for a range of random walk lengths around 'random_walk_length' on the calling thread, and returns the one
+// with the lowest relative variance times time per sample, which needs the least CPU time for a given precision.
+// If no candidate has enough non-zero estimates for a finite, positive relative variance, 'random_walk_length' is returned unchanged.
+// The estimator is unbiased for any random walk length, so the length only trades the time per sample against the variance.
+// Candidates are tried from long to short walks, since short walks can make backtracking arbitrarily slow.
+// The pilot samples use their own random streams derived from 'seed', and are not part of the results.
+// The supported values of N and M are explicitly instantiated in Tuning.cpp.
+template<int N, int M>
+int tune_random_walk_length(int random_walk_length, uint64_t seed);